@@ -0,0 +1,15 @@
+-- ----------------------------------------
+-- Per-character gathering XP of the current day, for the daily caps
+-- Rows stamped with an earlier reset_time are stale and start over on the next gather
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `character_gathering_daily` (
+    `guid` INT UNSIGNED NOT NULL,
+    `reset_time` INT UNSIGNED NOT NULL DEFAULT 0,
+    `mining_xp` INT UNSIGNED NOT NULL DEFAULT 0,
+    `herbalism_xp` INT UNSIGNED NOT NULL DEFAULT 0,
+    `skinning_xp` INT UNSIGNED NOT NULL DEFAULT 0,
+    `fishing_xp` INT UNSIGNED NOT NULL DEFAULT 0,
+    `total_xp` INT UNSIGNED NOT NULL DEFAULT 0,
+    PRIMARY KEY (`guid`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,11 @@
+-- ----------------------------------------
+-- Per-character module preferences, a bit mask
+-- Bit 0: hide gathering XP notifications
+-- Characters with default preferences have no row
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `character_gathering_preferences` (
+    `guid` INT UNSIGNED NOT NULL,
+    `flags` INT UNSIGNED NOT NULL DEFAULT 0,
+    PRIMARY KEY (`guid`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
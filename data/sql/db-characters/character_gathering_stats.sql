@@ -0,0 +1,14 @@
+-- ----------------------------------------
+-- Per-character gathering statistics
+-- The profession index lets a leaderboard refill read only its top rows
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `character_gathering_stats` (
+    `guid` INT UNSIGNED NOT NULL,
+    `profession` TINYINT UNSIGNED NOT NULL,
+    `gathers` INT UNSIGNED NOT NULL DEFAULT 0,
+    `xp_earned` BIGINT UNSIGNED NOT NULL DEFAULT 0,
+    `last_item_id` INT UNSIGNED NOT NULL DEFAULT 0,
+    PRIMARY KEY (`guid`, `profession`),
+    KEY `idx_profession_gathers` (`profession`, `gathers`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,16 @@
+-- ----------------------------------------
+-- Gathering XP rate overrides (VIP tiers, opt-outs)
+-- Account and character rates multiply, 0 disables gathering XP
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `account_gathering_rate` (
+    `account_id` INT UNSIGNED NOT NULL,
+    `multiplier` FLOAT NOT NULL DEFAULT 1,
+    PRIMARY KEY (`account_id`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+CREATE TABLE IF NOT EXISTS `character_gathering_rate` (
+    `guid` INT UNSIGNED NOT NULL,
+    `multiplier` FLOAT NOT NULL DEFAULT 1,
+    PRIMARY KEY (`guid`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,7 @@
+-- ----------------------------------------
+-- Recommended level per gathering item
+-- NULL derives the level from base_xp at load
+-- ----------------------------------------
+
+ALTER TABLE `gathering_experience`
+    ADD COLUMN `recommended_level` TINYINT UNSIGNED NULL DEFAULT NULL AFTER `profession`;
@@ -0,0 +1,16 @@
+-- ----------------------------------------
+-- Scheduled gathering XP multiplier events
+-- profession 0 applies to all professions, zone_id 0 to all zones
+-- Overlapping events multiply
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `gathering_experience_events` (
+    `id` INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    `name` VARCHAR(100) NOT NULL DEFAULT '',
+    `start_time` DATETIME NOT NULL,
+    `end_time` DATETIME NOT NULL,
+    `profession` TINYINT UNSIGNED NOT NULL DEFAULT 0,
+    `zone_id` INT UNSIGNED NOT NULL DEFAULT 0,
+    `multiplier` FLOAT NOT NULL DEFAULT 1,
+    PRIMARY KEY (`id`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
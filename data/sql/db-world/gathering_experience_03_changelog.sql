@@ -0,0 +1,12 @@
+-- ----------------------------------------
+-- Change log shared by all worldservers on this world database
+-- change_type: 0 = full reload, 1 = item, 2 = zone, 3 = profession setting
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `gathering_experience_changelog` (
+    `version` BIGINT UNSIGNED NOT NULL AUTO_INCREMENT,
+    `change_type` TINYINT UNSIGNED NOT NULL,
+    `entity_id` INT UNSIGNED NOT NULL DEFAULT 0,
+    `changed_at` TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (`version`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
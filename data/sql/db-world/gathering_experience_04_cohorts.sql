@@ -0,0 +1,13 @@
+-- ----------------------------------------
+-- XP experiment cohorts
+-- Players are split evenly over cohort ids 0..N-1 by a hash of their GUID
+-- profession 0 applies to all professions, specific rows override it
+-- No rows means no experiment
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `gathering_experience_cohorts` (
+    `cohort_id` TINYINT UNSIGNED NOT NULL,
+    `profession` TINYINT UNSIGNED NOT NULL DEFAULT 0,
+    `multiplier` FLOAT NOT NULL DEFAULT 1,
+    PRIMARY KEY (`cohort_id`, `profession`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,14 @@
+-- ----------------------------------------
+-- Gathers and XP per zone, 100 yard map cell and profession
+-- cell_x/cell_y are floor(position / 100)
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `gathering_experience_heatmap` (
+    `zone_id` INT UNSIGNED NOT NULL,
+    `cell_x` SMALLINT NOT NULL,
+    `cell_y` SMALLINT NOT NULL,
+    `profession` TINYINT UNSIGNED NOT NULL,
+    `gathers` INT UNSIGNED NOT NULL DEFAULT 0,
+    `xp` BIGINT UNSIGNED NOT NULL DEFAULT 0,
+    PRIMARY KEY (`zone_id`, `cell_x`, `cell_y`, `profession`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
@@ -0,0 +1,12 @@
+-- ----------------------------------------
+-- Zones where items naturally gather
+-- Items with rows here only give full XP when looted in one of their zones,
+-- elsewhere their XP is scaled by GatheringExperience.ItemZones.Factor
+-- Items without rows give XP in every zone
+-- ----------------------------------------
+
+CREATE TABLE IF NOT EXISTS `gathering_experience_item_zones` (
+    `item_id` INT UNSIGNED NOT NULL,
+    `zone_id` INT UNSIGNED NOT NULL,
+    PRIMARY KEY (`item_id`, `zone_id`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
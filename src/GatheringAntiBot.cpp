@@ -0,0 +1,108 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringAntiBot.h"
+#include "CharacterCache.h"
+#include "GatheringPlayerData.h"
+#include "Timer.h"
+#include <cmath>
+
+GatheringAntiBot* GatheringAntiBot::instance()
+{
+    static GatheringAntiBot instance;
+    return &instance;
+}
+
+void GatheringAntiBot::LoadConfig()
+{
+    enabled = sConfigMgr->GetOption<bool>("GatheringExperience.AntiBot.Enable", true);
+    zeroXP = sConfigMgr->GetOption<bool>("GatheringExperience.AntiBot.ZeroXP", false);
+    maxRate = sConfigMgr->GetOption<float>("GatheringExperience.AntiBot.MaxRate", 20.0f);
+    minVariation = sConfigMgr->GetOption<float>("GatheringExperience.AntiBot.MinVariation", 0.1f);
+    minSamples = std::max(2u, sConfigMgr->GetOption<uint32>("GatheringExperience.AntiBot.MinSamples", 30));
+    halfLife = std::max(1u, sConfigMgr->GetOption<uint32>("GatheringExperience.AntiBot.HalfLife", 300)) * 1000.0f;
+    reportCooldown = sConfigMgr->GetOption<uint32>("GatheringExperience.AntiBot.ReportCooldown", 600) * 1000;
+
+    // Interval averages span roughly the sample window
+    intervalWeight = 2.0f / (minSamples + 1);
+}
+
+bool GatheringAntiBot::OnGather(GatheringGatherer const& gatherer, ObjectGuid lootGuid)
+{
+    if (!enabled || !gatherer.data)
+        return false;
+
+    GatheringRateTracker& rate = gatherer.data->rate;
+
+    // Several items from one node or corpse are a single gather
+    if (!lootGuid.IsEmpty() && lootGuid.GetRawValue() == rate.lastLootGuid)
+        return rate.flagged && zeroXP;
+
+    uint32 now = getMSTime();
+    rate.lastLootGuid = lootGuid.GetRawValue();
+
+    if (!rate.samples++)
+    {
+        rate.lastGatherTime = now;
+        rate.decayedCount = 1.0f;
+        return false;
+    }
+
+    float interval = static_cast<float>(getMSTimeDiff(rate.lastGatherTime, now));
+    rate.lastGatherTime = now;
+
+    // Gathers per half-life; in steady state count * ln(2) / halfLife is the rate
+    rate.decayedCount = rate.decayedCount * std::exp2(-interval / halfLife) + 1.0f;
+
+    float delta = interval - rate.intervalMean;
+    rate.intervalMean += intervalWeight * delta;
+    rate.intervalVariance = (1.0f - intervalWeight) * (rate.intervalVariance + intervalWeight * delta * delta);
+
+    if (rate.samples < minSamples)
+        return false;
+
+    float gathersPerMinute = rate.decayedCount * 0.6931472f / halfLife * 60000.0f;
+    float variation = rate.intervalMean > 0.0f ? std::sqrt(rate.intervalVariance) / rate.intervalMean : 0.0f;
+
+    bool suspicious = gathersPerMinute > maxRate || variation < minVariation;
+    // Mock players are never reported to GMs
+    if (suspicious && !gatherer.sandbox && (!rate.flagged || getMSTimeDiff(rate.lastReportTime, now) >= reportCooldown))
+    {
+        rate.lastReportTime = now;
+
+        // Within the reserved capacity, so never allocates
+        std::lock_guard<std::mutex> guard(reportLock);
+        if (pendingReports.size() < MAX_PENDING_REPORTS)
+            pendingReports.push_back({ gatherer.guid, gathersPerMinute, rate.intervalMean, variation, zeroXP });
+    }
+
+    rate.flagged = suspicious;
+    return suspicious && zeroXP;
+}
+
+void GatheringAntiBot::SendReports()
+{
+    std::vector<Report> reports;
+    {
+        std::lock_guard<std::mutex> guard(reportLock);
+        if (pendingReports.empty())
+            return;
+        reports.assign(pendingReports.begin(), pendingReports.end());
+        pendingReports.clear();
+    }
+
+    for (Report const& report : reports)
+    {
+        std::string name;
+        if (!sCharacterCache->GetCharacterNameByGuid(report.guid, name))
+            name = std::to_string(report.guid.GetCounter());
+
+        std::string message = Acore::StringFormat(
+            "|cffff0000[Gathering]|r {} looks like a gathering bot: {:.1f} gathers/min, interval {:.1f}s +/- {:.0f}%{}",
+            name, report.gathersPerMinute, report.intervalMean / 1000.0f, report.variation * 100.0f,
+            report.withheld ? ", gathering XP withheld" : "");
+        LOG_INFO("module", "{}", message);
+        ChatHandler(nullptr).SendGlobalGMSysMessage(message.c_str());
+    }
+}
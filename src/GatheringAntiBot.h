@@ -0,0 +1,57 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_ANTIBOT_H
+#define MODULE_GATHERING_EXPERIENCE_ANTIBOT_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include <mutex>
+
+// Flags players whose gathering is too fast or too regular to be manual.
+// Each gather updates a few decayed counters in the player's data slot;
+// reports are queued and sent to game masters from the world update.
+class GatheringAntiBot
+{
+public:
+    // Reports waiting for the world update; players are rate limited by the
+    // report cooldown, so more than this in one update are dropped
+    static const uint32 MAX_PENDING_REPORTS = 64;
+
+    static GatheringAntiBot* instance();
+
+    void LoadConfig();
+
+    // Returns true while the player is considered a bot and XP should be withheld.
+    // Events with the same loot guid count once; an empty guid always counts.
+    bool OnGather(GatheringGatherer const& gatherer, ObjectGuid lootGuid);
+
+    // Sends queued reports, world thread only
+    void SendReports();
+
+private:
+    // Measurements only, the message is formatted on the world thread
+    struct Report
+    {
+        ObjectGuid guid;
+        float gathersPerMinute;
+        float intervalMean;
+        float variation;
+        bool withheld;
+    };
+
+    GatheringAntiBot() { pendingReports.reserve(MAX_PENDING_REPORTS); }
+
+    bool enabled{true};
+    bool zeroXP{false};
+    float maxRate{20.0f};
+    float minVariation{0.1f};
+    uint32 minSamples{30};
+    float halfLife{300000.0f};
+    float intervalWeight{0.0645f};
+    uint32 reportCooldown{600000};
+
+    std::mutex reportLock;
+    std::vector<Report> pendingReports;
+};
+
+#define sGatheringAntiBot GatheringAntiBot::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_ANTIBOT_H
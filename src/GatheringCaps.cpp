@@ -0,0 +1,147 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringCaps.h"
+#include "GatheringNotify.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include "Player.h"
+#include "Timer.h"
+
+GatheringCaps* GatheringCaps::instance()
+{
+    static GatheringCaps instance;
+    return &instance;
+}
+
+void GatheringCaps::LoadConfig()
+{
+    static char const* const options[GATHERING_PROFESSION_COUNT] =
+    {
+        "GatheringExperience.DailyCap.Mining",
+        "GatheringExperience.DailyCap.Herbalism",
+        "GatheringExperience.DailyCap.Skinning",
+        "GatheringExperience.DailyCap.Fishing"
+    };
+
+    // A cap of 0 means none; uncapped is stored as the largest value so
+    // checking a cap is the same compare either way
+    uint32 total = sConfigMgr->GetOption<uint32>("GatheringExperience.DailyCap.Total", 0);
+    totalCap = total ? total : UNCAPPED;
+    enabled = total != 0;
+
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+    {
+        uint32 cap = sConfigMgr->GetOption<uint32>(options[i], 0);
+        professionCaps[i] = cap ? cap : UNCAPPED;
+        enabled |= cap != 0;
+    }
+
+    resetHour = static_cast<uint8>(std::min<uint32>(sConfigMgr->GetOption<uint32>("GatheringExperience.DailyCap.ResetHour", 6), 23));
+    resetTime = static_cast<uint32>(Acore::Time::GetNextTimeWithDayAndHour(-1, resetHour));
+}
+
+void GatheringCaps::Update()
+{
+    if (!enabled || GameTime::GetGameTime().count() < resetTime.load(std::memory_order_relaxed))
+        return;
+
+    resetTime.store(static_cast<uint32>(Acore::Time::GetNextTimeWithDayAndHour(-1, resetHour)), std::memory_order_relaxed);
+    LOG_INFO("module", "Gathering daily XP caps reset, next reset at {}", resetTime.load(std::memory_order_relaxed));
+}
+
+void GatheringCaps::LoadPlayerXP(GatheringPlayerData& data, Field* fields)
+{
+    // reset_time, the four profession counters, total_xp; null without a row
+    if (!enabled || fields[0].IsNull())
+        return;
+
+    // Counters of an earlier day are kept as they are and cleared on the next gather
+    data.daily.resetTime = fields[0].Get<uint32>();
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        data.daily.professionXP[i] = fields[i + 1].Get<uint32>();
+    data.daily.totalXP = fields[5].Get<uint32>();
+}
+
+void GatheringCaps::SavePlayerXP(Player* player)
+{
+    GatheringPlayerData* data = GatheringPlayerData::Get(player);
+    if (!data || !data->daily.dirty)
+        return;
+
+    GatheringDailyXP const& daily = data->daily;
+    CharacterDatabase.Execute(
+        "REPLACE INTO character_gathering_daily (guid, reset_time, mining_xp, herbalism_xp, skinning_xp, fishing_xp, total_xp) "
+        "VALUES ({}, {}, {}, {}, {}, {}, {})",
+        player->GetGUID().GetCounter(), daily.resetTime, daily.professionXP[0], daily.professionXP[1],
+        daily.professionXP[2], daily.professionXP[3], daily.totalXP);
+    data->daily.dirty = false;
+}
+
+void GatheringCaps::DeleteCharacterXP(ObjectGuid guid)
+{
+    CharacterDatabase.Execute("DELETE FROM character_gathering_daily WHERE guid = {}", guid.GetCounter());
+}
+
+uint32 GatheringCaps::Apply(GatheringGatherer const& gatherer, uint8 profession, uint32 xp)
+{
+    if (!enabled || !xp || profession < PROF_MINING || profession > PROF_FISHING || !gatherer.data)
+        return xp;
+
+    // First gather after a reset starts the day over
+    GatheringDailyXP& daily = gatherer.data->daily;
+    uint32 currentReset = resetTime.load(std::memory_order_relaxed);
+    if (daily.resetTime != currentReset)
+    {
+        daily = GatheringDailyXP();
+        daily.resetTime = currentReset;
+    }
+
+    uint32& professionXP = daily.professionXP[profession - 1];
+    uint32 professionCap = professionCaps[profession - 1];
+    if (daily.totalXP >= totalCap || professionXP >= professionCap)
+        return 0;
+
+    xp = std::min({ xp, totalCap - daily.totalXP, professionCap - professionXP });
+    professionXP += xp;
+    daily.totalXP += xp;
+    daily.dirty = true;
+
+    // Mock players have nobody to tell
+    if (gatherer.sandbox)
+        return xp;
+
+    // Told from the world update, with the XP message of this loot
+    if (daily.totalXP >= totalCap)
+        sGatheringNotify->OnCapReached(gatherer, GATHERING_CAP_TOTAL);
+    else if (professionXP >= professionCap)
+        sGatheringNotify->OnCapReached(gatherer, GATHERING_CAP_PROFESSION);
+
+    return xp;
+}
+
+uint32 GatheringCaps::GetProfessionXP(GatheringPlayerData const* data, uint8 profession) const
+{
+    if (!data || profession < PROF_MINING || profession > PROF_FISHING || data->daily.resetTime != resetTime.load(std::memory_order_relaxed))
+        return 0;
+
+    return data->daily.professionXP[profession - 1];
+}
+
+uint32 GatheringCaps::GetTotalXP(GatheringPlayerData const* data) const
+{
+    if (!data || data->daily.resetTime != resetTime.load(std::memory_order_relaxed))
+        return 0;
+
+    return data->daily.totalXP;
+}
+
+uint32 GatheringCaps::GetProfessionCap(uint8 profession) const
+{
+    if (profession < PROF_MINING || profession > PROF_FISHING || professionCaps[profession - 1] == UNCAPPED)
+        return 0;
+
+    return professionCaps[profession - 1];
+}
@@ -0,0 +1,53 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_CAPS_H
+#define MODULE_GATHERING_EXPERIENCE_CAPS_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include <atomic>
+#include <limits>
+
+// Daily gathering XP caps, per profession and overall. Each player's
+// counters carry the reset time they count towards. The world update only
+// moves the current reset time forward, and a player's counters start over
+// the first time they gather after that, so no reset ever visits every
+// player. Counters are saved with the character.
+class GatheringCaps
+{
+public:
+    static GatheringCaps* instance();
+
+    void LoadConfig();
+
+    // World thread only, advances the reset time once it has passed
+    void Update();
+
+    // Daily XP columns of the login query, see GatheringPlayerData::Load
+    void LoadPlayerXP(GatheringPlayerData& data, Field* fields);
+    void SavePlayerXP(Player* player);
+    void DeleteCharacterXP(ObjectGuid guid);
+
+    // Part of a gather's XP that still fits under today's caps, counted
+    uint32 Apply(GatheringGatherer const& gatherer, uint8 profession, uint32 xp);
+
+    // Today's XP, zero while the counters are from an earlier day
+    uint32 GetProfessionXP(GatheringPlayerData const* data, uint8 profession) const;
+    uint32 GetTotalXP(GatheringPlayerData const* data) const;
+
+    // 0 when uncapped
+    uint32 GetProfessionCap(uint8 profession) const;
+    uint32 GetTotalCap() const { return totalCap == UNCAPPED ? 0 : totalCap; }
+    bool IsEnabled() const { return enabled; }
+
+private:
+    static constexpr uint32 UNCAPPED = std::numeric_limits<uint32>::max();
+
+    bool enabled{false};
+    uint8 resetHour{6};
+    std::array<uint32, GATHERING_PROFESSION_COUNT> professionCaps{ UNCAPPED, UNCAPPED, UNCAPPED, UNCAPPED };
+    uint32 totalCap{UNCAPPED};
+    std::atomic<uint32> resetTime{0};
+};
+
+#define sGatheringCaps GatheringCaps::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_CAPS_H
@@ -0,0 +1,234 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringCapture.h"
+#include "Log.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    const char CAPTURE_MAGIC[8] = { 'G', 'E', 'C', 'A', 'P', 'T', '1', '\0' };
+}
+
+GatheringCapture* GatheringCapture::instance()
+{
+    static GatheringCapture instance;
+    return &instance;
+}
+
+GatheringCapture::~GatheringCapture()
+{
+    Close();
+}
+
+void GatheringCapture::Configure(std::string const& path, uint32 capacity)
+{
+    if (path == filePath && (!header || header->capacity == capacity))
+        return;
+
+    // Config loads run on the world thread while no map is updating
+    Close();
+    filePath = path;
+    if (path.empty() || !capacity)
+        return;
+
+    namespace bip = boost::interprocess;
+
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path(), error);
+
+    // Create the file if needed and size it for the ring before mapping it
+    std::ofstream(path, std::ios::binary | std::ios::app).close();
+    std::filesystem::resize_file(target, sizeof(GatheringCaptureHeader) + std::size_t(capacity) * sizeof(GatheringCaptureRecord), error);
+    if (error)
+    {
+        LOG_ERROR("module", "Could not size gathering capture file {}: {}", path, error.message());
+        return;
+    }
+
+    try
+    {
+        bip::file_mapping mapping(path.c_str(), bip::read_write);
+        region = std::make_unique<bip::mapped_region>(mapping, bip::read_write);
+    }
+    catch (bip::interprocess_exception const& e)
+    {
+        LOG_ERROR("module", "Failed to map gathering capture file {}: {}", path, e.what());
+        return;
+    }
+
+    header = static_cast<GatheringCaptureHeader*>(region->get_address());
+    records = reinterpret_cast<GatheringCaptureRecord*>(header + 1);
+
+    // Keep appending to a capture of the same shape, start over otherwise
+    if (memcmp(header->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0 ||
+        header->recordSize != sizeof(GatheringCaptureRecord) || header->capacity != capacity)
+    {
+        memcpy(header->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+        header->recordSize = sizeof(GatheringCaptureRecord);
+        header->capacity = capacity;
+        header->written = 0;
+    }
+
+    LOG_INFO("module", "Capturing gathering loot to {} ({} records, {} already written)", path, capacity, header->written);
+}
+
+void GatheringCapture::Close()
+{
+    if (region)
+        region->flush(0, 0, true);
+
+    region.reset();
+    header = nullptr;
+    records = nullptr;
+}
+
+void GatheringCapture::Record(GatheringCaptureRecord const& record)
+{
+    if (!records)
+        return;
+
+    // Map threads append concurrently, each claims its own slot
+    uint64 slot = std::atomic_ref<uint64>(header->written).fetch_add(1, std::memory_order_relaxed);
+    records[slot % header->capacity] = record;
+}
+
+bool GatheringReplayTask::Step(ChatHandler* handler)
+{
+    if (!opened)
+    {
+        opened = true;
+
+        std::string error;
+        if (!Open(error))
+        {
+            handler->PSendSysMessage("Replay failed: {}", error);
+            return true;
+        }
+    }
+
+    if (!remaining)
+    {
+        Finish(handler);
+        return true;
+    }
+
+    uint64 count = std::min<uint64>({ RECORDS_PER_STEP, remaining, wrapAt });
+    buffer.resize(count);
+    if (!in.read(reinterpret_cast<char*>(buffer.data()), count * sizeof(GatheringCaptureRecord)))
+    {
+        handler->PSendSysMessage("Replay failed: {} is truncated", path);
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (GatheringCaptureRecord const& record : buffer)
+        Replay(record);
+    nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    remaining -= count;
+    wrapAt -= count;
+    if (!wrapAt && remaining)
+    {
+        in.seekg(firstRecord);
+        wrapAt = remaining;
+    }
+
+    return false;
+}
+
+bool GatheringReplayTask::Open(std::string& error)
+{
+    in.open(path, std::ios::binary);
+    if (!in)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    GatheringCaptureHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0 ||
+        header.recordSize != sizeof(GatheringCaptureRecord) || !header.capacity)
+    {
+        error = path + " is not a gathering capture file";
+        return false;
+    }
+
+    firstRecord = sizeof(GatheringCaptureHeader);
+    remaining = std::min<uint64>(header.written, header.capacity);
+    wrapAt = remaining;
+
+    // A wrapped ring starts with its oldest record at the next slot
+    if (header.written > header.capacity)
+    {
+        uint64 oldest = header.written % header.capacity;
+        in.seekg(firstRecord + std::streamoff(oldest * sizeof(GatheringCaptureRecord)));
+        wrapAt = header.capacity - oldest;
+    }
+
+    return true;
+}
+
+void GatheringReplayTask::Replay(GatheringCaptureRecord const& record)
+{
+    ++replayed;
+
+    GatheringItem const* item = snapshot->items.Find(record.itemId);
+    if (!item)
+    {
+        ++missing;
+        return;
+    }
+
+    recordedXP += record.xp;
+
+    GatheringXPInput input;
+    input.level = record.level;
+    input.skill = record.skill;
+    input.zoneMultiplier = item->profession == PROF_FISHING ? GatheringFormula::GetZoneMultiplier(*snapshot, record.zoneId) : 1.0f;
+
+    // Same order of truncations as the live path
+    uint32 xp = GatheringFormula::Compute(*item, input).finalXP;
+    if (record.flags & GATHERING_CAPTURE_NODE)
+        xp = static_cast<uint32>(xp * record.nodeFactor);
+    if (record.multiplier != 1.0f)
+        xp = std::min(static_cast<uint32>(xp * record.multiplier), MAX_EXPERIENCE_GAIN);
+
+    replayedXP += xp;
+    if (xp == record.xp)
+        ++unchanged;
+    else
+        ++changedItems[record.itemId];
+}
+
+void GatheringReplayTask::Finish(ChatHandler* handler)
+{
+    handler->PSendSysMessage("Replayed {} gathers from {}: {} unchanged, {} changed, {} with items no longer loaded.",
+        replayed, path, unchanged, replayed - unchanged - missing, missing);
+    handler->PSendSysMessage("Recorded XP {}, replayed XP {} ({:+.2f}%), {:.0f} ns per gather.",
+        recordedXP, replayedXP, recordedXP ? (double(replayedXP) - double(recordedXP)) * 100.0 / recordedXP : 0.0,
+        replayed ? double(nanoseconds) / replayed : 0.0);
+
+    uint32 shown = 0;
+    for (auto const& [itemId, count] : changedItems)
+    {
+        if (++shown > 10)
+        {
+            handler->PSendSysMessage("... and {} more items", changedItems.size() - 10);
+            break;
+        }
+
+        GatheringItem const* item = snapshot->items.Find(itemId);
+        handler->PSendSysMessage("XP changed for item {} ({}) in {} gathers", itemId, item ? snapshot->items.GetName(*item) : "", count);
+    }
+}
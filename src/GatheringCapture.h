@@ -0,0 +1,111 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_CAPTURE_H
+#define MODULE_GATHERING_EXPERIENCE_CAPTURE_H
+
+#include "GatheringExperience.h"
+#include "GatheringTasks.h"
+#include <fstream>
+#include <map>
+#include <memory>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
+
+enum GatheringCaptureFlags
+{
+    GATHERING_CAPTURE_NODE     = 0x01, // Scored per harvested node
+    GATHERING_CAPTURE_WITHHELD = 0x02  // XP withheld by the bot detector
+};
+
+// One awarded gather, written as is into the capture file
+struct GatheringCaptureRecord
+{
+    uint64 timestamp;  // Milliseconds since the Unix epoch
+    uint64 playerGuid;
+    uint32 itemId;
+    uint32 zoneId;
+    uint32 xp;         // After multipliers, before the bot check
+    float multiplier;  // Event multiplier times rate override
+    float nodeFactor;  // Node color factor, 1 for per item XP
+    uint16 skill;
+    uint8 count;
+    uint8 level;
+    uint8 profession;
+    uint8 flags;
+    uint8 reserved[6];
+};
+
+static_assert(sizeof(GatheringCaptureRecord) == 48, "capture records are a fixed on-disk size");
+
+struct GatheringCaptureHeader
+{
+    char magic[8];
+    uint32 recordSize;
+    uint32 capacity;
+    uint64 written;    // Records ever appended, the next slot is written % capacity
+};
+
+// Records awarded gathers into a memory mapped ring file. Appending claims a
+// slot with one atomic add and copies the record into the mapping; the file
+// keeps the newest records once it wraps and survives restarts.
+class GatheringCapture
+{
+public:
+    static GatheringCapture* instance();
+    ~GatheringCapture();
+
+    // Opens, resizes or (with an empty path) closes the capture file
+    void Configure(std::string const& path, uint32 capacity);
+
+    bool IsEnabled() const { return records != nullptr; }
+
+    void Record(GatheringCaptureRecord const& record);
+
+private:
+    void Close();
+
+    std::string filePath;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    GatheringCaptureHeader* header{nullptr};
+    GatheringCaptureRecord* records{nullptr};
+};
+
+#define sGatheringCapture GatheringCapture::instance()
+
+// Feeds a capture file back through the XP formulas against the current
+// snapshot, oldest record first, and compares with the XP recorded live.
+class GatheringReplayTask : public GatheringTask
+{
+public:
+    static const uint32 RECORDS_PER_STEP = 4096;
+
+    GatheringReplayTask(std::string path, std::shared_ptr<GatheringSnapshot const> snapshot)
+        : path(std::move(path)), snapshot(std::move(snapshot)) { }
+
+    bool Step(ChatHandler* handler) override;
+
+private:
+    bool Open(std::string& error);
+    void Replay(GatheringCaptureRecord const& record);
+    void Finish(ChatHandler* handler);
+
+    std::string path;
+    std::shared_ptr<GatheringSnapshot const> snapshot;
+    std::ifstream in;
+    std::vector<GatheringCaptureRecord> buffer;
+    bool opened{false};
+    uint64 remaining{0};
+    uint64 wrapAt{0};  // Records left before reading continues at the file start
+    std::streamoff firstRecord{0};
+
+    uint64 replayed{0};
+    uint64 unchanged{0};
+    uint64 missing{0};  // Items no longer loaded
+    uint64 recordedXP{0};
+    uint64 replayedXP{0};
+    uint64 nanoseconds{0};
+    std::map<uint32, uint32> changedItems;
+};
+
+#endif //MODULE_GATHERING_EXPERIENCE_CAPTURE_H
@@ -0,0 +1,148 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringEvents.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include <algorithm>
+#include <limits>
+
+GatheringEvents* GatheringEvents::instance()
+{
+    static GatheringEvents instance;
+    return &instance;
+}
+
+void GatheringEvents::LoadFromDB()
+{
+    events.clear();
+    time_t now = GameTime::GetGameTime().count();
+
+    QueryResult result = WorldDatabase.Query(
+        "SELECT id, name, UNIX_TIMESTAMP(start_time), UNIX_TIMESTAMP(end_time), profession, zone_id, multiplier "
+        "FROM gathering_experience_events");
+    if (result)
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            GatheringEvent event;
+            event.id = fields[0].Get<uint32>();
+            event.name = fields[1].Get<std::string>();
+            event.start = fields[2].Get<uint64>();
+            event.end = fields[3].Get<uint64>();
+            event.profession = fields[4].Get<uint8>();
+            event.zoneId = fields[5].Get<uint32>();
+            event.multiplier = fields[6].Get<float>();
+
+            if (event.profession > GATHERING_PROFESSION_COUNT || event.multiplier < 0.0f || event.end <= event.start)
+            {
+                LOG_ERROR("module", "Gathering XP event {} has an invalid profession, multiplier or time window, skipped", event.id);
+                continue;
+            }
+
+            // Finished events never matter again
+            if (event.end <= now)
+                continue;
+
+            events.push_back(std::move(event));
+        } while (result->NextRow());
+    }
+
+    std::sort(events.begin(), events.end(), [](GatheringEvent const& a, GatheringEvent const& b) { return a.start < b.start; });
+
+    // Every start and end still ahead of us begins a new segment
+    std::vector<time_t> boundaries{ now };
+    for (GatheringEvent const& event : events)
+    {
+        if (event.start > now)
+            boundaries.push_back(event.start);
+        boundaries.push_back(event.end);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    schedule.clear();
+    for (time_t boundary : boundaries)
+        schedule.push_back({ boundary, BuildState(boundary) });
+
+    nextSegment = 0;
+    nextBoundary = 0;
+    Update();
+
+    LOG_INFO("module", "Loaded {} gathering XP events into {} schedule segments", events.size(), schedule.size());
+}
+
+std::shared_ptr<GatheringEventState const> GatheringEvents::BuildState(time_t time)
+{
+    auto built = std::make_shared<GatheringEventState>();
+    built->epoch = ++epoch;
+
+    for (GatheringEvent const& event : events)
+    {
+        if (event.start > time || event.end <= time)
+            continue;
+
+        built->activeEvents.push_back(event.id);
+
+        std::array<float, GATHERING_PROFESSION_COUNT>* multipliers = &built->multipliers;
+        if (event.zoneId)
+        {
+            auto& zones = built->zoneMultipliers;
+            auto itr = std::lower_bound(zones.begin(), zones.end(), event.zoneId,
+                [](GatheringZoneEventMultipliers const& zone, uint32 zoneId) { return zone.zoneId < zoneId; });
+            if (itr == zones.end() || itr->zoneId != event.zoneId)
+                itr = zones.insert(itr, { event.zoneId, { 1.0f, 1.0f, 1.0f, 1.0f } });
+            multipliers = &itr->multipliers;
+        }
+
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+            if (!event.profession || event.profession == i + 1)
+                (*multipliers)[i] *= event.multiplier;
+    }
+
+    return built;
+}
+
+void GatheringEvents::Update()
+{
+    time_t now = GameTime::GetGameTime().count();
+    if (now < nextBoundary)
+        return;
+
+    Segment const* due = nullptr;
+    while (nextSegment < schedule.size() && schedule[nextSegment].start <= now)
+        due = &schedule[nextSegment++];
+
+    nextBoundary = nextSegment < schedule.size() ? schedule[nextSegment].start : std::numeric_limits<time_t>::max();
+
+    if (!due)
+        return;
+
+    std::atomic_store(&state, due->state);
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        multipliers[i].store(due->state->multipliers[i], std::memory_order_relaxed);
+    hasZoneEvents.store(!due->state->zoneMultipliers.empty(), std::memory_order_release);
+
+    LOG_INFO("module", "Gathering XP events epoch {}: {} event(s) active", due->state->epoch, due->state->activeEvents.size());
+}
+
+float GatheringEvents::GetMultiplier(uint8 profession, uint32 zoneId) const
+{
+    if (!profession || profession > GATHERING_PROFESSION_COUNT)
+        return 1.0f;
+
+    float multiplier = multipliers[profession - 1].load(std::memory_order_relaxed);
+    if (!hasZoneEvents.load(std::memory_order_acquire))
+        return multiplier;
+
+    // Zone events are rare, only they pin the state
+    auto current = GetState();
+    auto const& zones = current->zoneMultipliers;
+    auto itr = std::lower_bound(zones.begin(), zones.end(), zoneId,
+        [](GatheringZoneEventMultipliers const& zone, uint32 id) { return zone.zoneId < id; });
+    if (itr != zones.end() && itr->zoneId == zoneId)
+        multiplier *= itr->multipliers[profession - 1];
+    return multiplier;
+}
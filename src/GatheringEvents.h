@@ -0,0 +1,79 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_EVENTS_H
+#define MODULE_GATHERING_EXPERIENCE_EVENTS_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// A row of gathering_experience_events; profession and zone 0 match everything
+struct GatheringEvent
+{
+    uint32 id;
+    std::string name;
+    time_t start;
+    time_t end;
+    uint8 profession;
+    uint32 zoneId;
+    float multiplier;
+};
+
+struct GatheringZoneEventMultipliers
+{
+    uint32 zoneId;
+    std::array<float, GATHERING_PROFESSION_COUNT> multipliers;
+};
+
+// Multipliers in effect between two schedule boundaries
+struct GatheringEventState
+{
+    uint32 epoch{0};
+    std::array<float, GATHERING_PROFESSION_COUNT> multipliers{ 1.0f, 1.0f, 1.0f, 1.0f };
+    std::vector<GatheringZoneEventMultipliers> zoneMultipliers; // Sorted by zone
+    std::vector<uint32> activeEvents;
+};
+
+// Timed XP multiplier events. The table is compiled at load into a sorted
+// list of precomputed states; the world update publishes the next one when
+// its start time passes. Looting reads the profession multipliers from
+// plain atomics and only loads the state while a zone event runs.
+class GatheringEvents
+{
+public:
+    static GatheringEvents* instance();
+
+    // World thread only
+    void LoadFromDB();
+    void Update();
+    std::vector<GatheringEvent> const& GetEvents() const { return events; }
+
+    std::shared_ptr<GatheringEventState const> GetState() const { return std::atomic_load(&state); }
+    float GetMultiplier(uint8 profession, uint32 zoneId) const;
+
+private:
+    struct Segment
+    {
+        time_t start;
+        std::shared_ptr<GatheringEventState const> state;
+    };
+
+    std::shared_ptr<GatheringEventState const> BuildState(time_t time);
+
+    std::vector<GatheringEvent> events;
+    std::vector<Segment> schedule;
+    size_t nextSegment{0};
+    time_t nextBoundary{0};
+    uint32 epoch{0};
+
+    std::shared_ptr<GatheringEventState const> state{std::make_shared<GatheringEventState>()};
+
+    // The current state's profession multipliers, and whether it has zones
+    std::array<std::atomic<float>, GATHERING_PROFESSION_COUNT> multipliers{ 1.0f, 1.0f, 1.0f, 1.0f };
+    std::atomic<bool> hasZoneEvents{false};
+};
+
+#define sGatheringEvents GatheringEvents::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_EVENTS_H
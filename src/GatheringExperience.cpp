@@ -9,10 +9,27 @@
 #include "Log.h"
 #include "StringFormat.h"
 #include "GatheringExperience.h"
+#include "GatheringSnapshotCache.h"
 #include "professions/Fishing.h"
 #include "professions/Skinning.h"
 #include "professions/Herbalism.h"
 #include "professions/Mining.h"
+#include "GatheringStats.h"
+#include "GatheringLeaderboard.h"
+#include "GatheringAntiBot.h"
+#include "GatheringProfiler.h"
+#include "GatheringEvents.h"
+#include "GatheringRates.h"
+#include "GatheringSync.h"
+#include "GatheringMetrics.h"
+#include "GatheringTasks.h"
+#include "GatheringCapture.h"
+#include "GatheringHeatmap.h"
+#include "GatheringCaps.h"
+#include "GatheringNotify.h"
+#include "GatheringStress.h"
+#include "GatheringScorer.h"
+#include <chrono>
 
 GatheringExperienceModule* GatheringExperienceModule::instance = nullptr;
 
@@ -21,41 +38,159 @@ const char* GATHERING_EXPERIENCE_VERSION = "0.6.1";
 
 void GatheringExperienceModule::LoadDataFromDB()
 {
+    GE_PROFILE_SCOPE("LoadDataFromDB");
+
     LOG_INFO("module", "Loading Gathering Experience data...");
-    
-    LoadSettingsFromDB();
-    LoadGatheringData();
+    auto loadStart = std::chrono::steady_clock::now();
+
+    // Changes logged from here on are picked up by the next sync poll
+    sGatheringSync->Reset();
 
-    // Load zone multipliers
-    QueryResult result = WorldDatabase.Query("SELECT * FROM gathering_experience_zones");
-    if (result)
+    auto data = std::make_shared<GatheringSnapshot>();
+
+    // Reuse the snapshot cache if the tables did not change since it was written
+    uint64 checksum = (cacheEnabled && !cachePath.empty()) ? QueryTableChecksum() : 0;
+    if (checksum && GatheringSnapshotCache::Load(cachePath, checksum, *data))
     {
-        uint32 count = 0;
-        do
-        {
-            Field* fields = result->Fetch();
-            zoneMultipliers[fields[0].Get<uint32>()] = fields[1].Get<float>();
-            count++;
-        } while (result->NextRow());
-        LOG_INFO("module", "Loaded {} zone multipliers", count);
+        LOG_INFO("module", "Loaded {} gathering items, {} zone multipliers and {} rarity multipliers from cache {}",
+            data->items.size(), data->zoneMultipliers.size(), data->rarityMultipliers.size(), cachePath);
     }
+    else
+    {
+        *data = GatheringSnapshot();
+        LoadSettingsData(*data);
+        LoadGatheringData(*data);
+        LoadZoneData(*data);
+        LoadRarityData(*data);
+        LoadCohortData(*data);
+        LoadItemZoneData(*data);
+
+        if (checksum && GatheringSnapshotCache::Save(cachePath, checksum, *data))
+            LOG_INFO("module", "Wrote gathering snapshot cache {}", cachePath);
+    }
+
+    data->ResolveRarity();
+    data->BuildNodeTiers();
+    data->BuildZoneEligibility();
+    ApplySettings(*data);
+    PublishSnapshot(std::move(data));
+
+    sGatheringEvents->LoadFromDB();
+
+    sGatheringMetrics->OnReload(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - loadStart).count());
+}
 
-    // Load rarity multipliers
-    result = WorldDatabase.Query("SELECT * FROM gathering_experience_rarity");
-    if (result)
+void GatheringExperienceModule::ApplyChanges(std::set<uint32> const& items, std::set<uint32> const& zones, bool settings)
+{
+    // Redone on top of whatever another thread published meanwhile, so a
+    // concurrent reload or edit is never lost
+    while (true)
     {
-        uint32 count = 0;
-        do
+        auto current = GetSnapshot();
+        auto data = std::make_shared<GatheringSnapshot>(*current);
+
+        if (!items.empty())
         {
-            Field* fields = result->Fetch();
-            zoneMultipliers[fields[0].Get<uint32>()] = fields[1].Get<float>();
-            count++;
-        } while (result->NextRow());
-        LOG_INFO("module", "Loaded {} rarity multipliers", count);
+            std::string ids;
+            for (uint32 itemId : items)
+            {
+                ids += (ids.empty() ? "" : ",") + std::to_string(itemId);
+                data->items.Erase(itemId);
+                data->rarityMultipliers.erase(itemId);
+            }
+
+            LoadGatheringData(*data, "item_id IN (" + ids + ")");
+            LoadRarityData(*data, "item_id IN (" + ids + ")");
+            data->ResolveRarity();
+            data->BuildNodeTiers();
+            data->BuildZoneEligibility();
+        }
+
+        if (!zones.empty())
+        {
+            std::string ids;
+            for (uint32 zoneId : zones)
+            {
+                ids += (ids.empty() ? "" : ",") + std::to_string(zoneId);
+                data->zoneMultipliers.erase(zoneId);
+            }
+
+            LoadZoneData(*data, "zone_id IN (" + ids + ")");
+        }
+
+        if (settings)
+        {
+            data->professionSettings.clear();
+            LoadSettingsData(*data);
+            ApplySettings(*data);
+        }
+
+        if (ReplaceSnapshot(current, std::move(data)))
+            return;
     }
 }
 
+void GatheringExperienceModule::PublishSnapshot(std::shared_ptr<GatheringSnapshot const> data)
+{
+    std::lock_guard<std::mutex> guard(publishLock);
+    currentSnapshot.store(data.get(), std::memory_order_release);
+    retiredSnapshots.emplace_back(std::atomic_exchange(&snapshot, std::move(data)), updateCount);
+}
+
+bool GatheringExperienceModule::ReplaceSnapshot(std::shared_ptr<GatheringSnapshot const> current, std::shared_ptr<GatheringSnapshot const> data)
+{
+    std::lock_guard<std::mutex> guard(publishLock);
+    GatheringSnapshot const* published = data.get();
+    if (!std::atomic_compare_exchange_strong(&snapshot, &current, std::move(data)))
+        return false;
+
+    currentSnapshot.store(published, std::memory_order_release);
+    retiredSnapshots.emplace_back(std::move(current), updateCount);
+    return true;
+}
+
+void GatheringExperienceModule::ReleaseRetiredSnapshots()
+{
+    // World updates run while no map is updating, so anything retired
+    // before the previous one can no longer be under a map thread's test
+    std::lock_guard<std::mutex> guard(publishLock);
+    ++updateCount;
+    std::erase_if(retiredSnapshots, [this](auto const& retired) { return updateCount - retired.second >= 2; });
+}
+
+uint64 GatheringExperienceModule::QueryTableChecksum()
+{
+    QueryResult result = WorldDatabase.Query(
+        "CHECKSUM TABLE gathering_experience, gathering_experience_zones, "
+        "gathering_experience_rarity, gathering_experience_settings, gathering_experience_cohorts, "
+        "gathering_experience_item_zones");
+    if (!result)
+        return 0;
+
+    uint64 checksum = GatheringSnapshotCache::Hash(&GatheringSnapshotCache::CACHE_VERSION, sizeof(uint32));
+    do
+    {
+        Field* fields = result->Fetch();
+        if (fields[1].IsNull()) // Table missing
+            return 0;
+
+        uint64 tableChecksum = fields[1].Get<uint64>();
+        checksum = GatheringSnapshotCache::Hash(&tableChecksum, sizeof(tableChecksum), checksum);
+    } while (result->NextRow());
+
+    // Zero means "no checksum available" to the caller
+    return checksum ? checksum : 1;
+}
+
 void GatheringExperienceModule::LoadSettingsFromDB()
+{
+    GatheringSnapshot data;
+    LoadSettingsData(data);
+    ApplySettings(data);
+}
+
+void GatheringExperienceModule::LoadSettingsData(GatheringSnapshot& data)
 {
     QueryResult result = WorldDatabase.Query("SELECT profession, enabled FROM gathering_experience_settings");
     if (!result)
@@ -68,37 +203,54 @@ void GatheringExperienceModule::LoadSettingsFromDB()
         bool enabled = fields[1].Get<bool>();
 
         if (profession == "Mining")
-            miningEnabled = enabled;
+            data.professionSettings.emplace_back(PROF_MINING, enabled);
         else if (profession == "Herbalism")
-            herbalismEnabled = enabled;
+            data.professionSettings.emplace_back(PROF_HERBALISM, enabled);
         else if (profession == "Skinning")
-            skinningEnabled = enabled;
+            data.professionSettings.emplace_back(PROF_SKINNING, enabled);
         else if (profession == "Fishing")
-            fishingEnabled = enabled;
+            data.professionSettings.emplace_back(PROF_FISHING, enabled);
     } while (result->NextRow());
 }
 
-void GatheringExperienceModule::LoadGatheringData()
+void GatheringExperienceModule::ApplySettings(GatheringSnapshot const& data)
 {
-    // Clear existing data
-    gatheringItems.clear();
+    for (auto const& [profession, enabled] : data.professionSettings)
+    {
+        switch (profession)
+        {
+            case PROF_MINING:    miningEnabled = enabled;    break;
+            case PROF_HERBALISM: herbalismEnabled = enabled; break;
+            case PROF_SKINNING:  skinningEnabled = enabled;  break;
+            case PROF_FISHING:   fishingEnabled = enabled;   break;
+            default: break;
+        }
+    }
+}
 
+void GatheringExperienceModule::LoadGatheringData(GatheringSnapshot& data, std::string const& filter)
+{
     // Load gathering items
     if (QueryResult result = WorldDatabase.Query(
-        "SELECT item_id, base_xp, required_skill, profession, name FROM gathering_experience"))
+        "SELECT item_id, base_xp, required_skill, profession, name, recommended_level FROM gathering_experience" +
+        (filter.empty() ? "" : " WHERE " + filter) + " ORDER BY item_id"))
     {
         uint32 count = 0;
         do
         {
             Field* fields = result->Fetch();
             uint32 itemId = fields[0].Get<uint32>();
+            uint32 baseXP = fields[1].Get<uint32>();
             GatheringItem item;
-            item.baseXP = fields[1].Get<uint32>();
-            item.requiredSkill = fields[2].Get<uint32>();
+            item.baseXP = static_cast<uint16>(std::min<uint32>(baseXP, UINT16_MAX));
+            item.requiredSkill = static_cast<uint16>(std::min<uint32>(fields[2].Get<uint32>(), UINT16_MAX));
             item.profession = fields[3].Get<uint8>();
-            item.name = fields[4].Get<std::string>();
-            item.rarity = 0; // Default to common if not specified
-            gatheringItems[itemId] = item;
+            item.rarity = 0; // Resolved from the rarity table once it is loaded
+            // Derive the recommended level from base XP if not specified
+            item.recommendedLevel = fields[5].IsNull()
+                ? GatheringFormula::GetDefaultRecommendedLevel(baseXP)
+                : fields[5].Get<uint8>();
+            data.items.Set(itemId, item, fields[4].Get<std::string>());
             count++;
         } while (result->NextRow());
         LOG_INFO("module", "Loaded {} gathering items", count);
@@ -109,6 +261,98 @@ void GatheringExperienceModule::LoadGatheringData()
     }
 }
 
+void GatheringExperienceModule::LoadZoneData(GatheringSnapshot& data, std::string const& filter)
+{
+    QueryResult result = WorldDatabase.Query("SELECT zone_id, multiplier FROM gathering_experience_zones" +
+        (filter.empty() ? "" : " WHERE " + filter));
+    if (!result)
+        return;
+
+    uint32 count = 0;
+    do
+    {
+        Field* fields = result->Fetch();
+        data.zoneMultipliers[fields[0].Get<uint32>()] = fields[1].Get<float>();
+        count++;
+    } while (result->NextRow());
+    LOG_INFO("module", "Loaded {} zone multipliers", count);
+}
+
+void GatheringExperienceModule::LoadRarityData(GatheringSnapshot& data, std::string const& filter)
+{
+    QueryResult result = WorldDatabase.Query("SELECT item_id, multiplier FROM gathering_experience_rarity" +
+        (filter.empty() ? "" : " WHERE " + filter));
+    if (!result)
+        return;
+
+    uint32 count = 0;
+    do
+    {
+        Field* fields = result->Fetch();
+        data.rarityMultipliers[fields[0].Get<uint32>()] = fields[1].Get<float>();
+        count++;
+    } while (result->NextRow());
+    LOG_INFO("module", "Loaded {} rarity multipliers", count);
+}
+
+void GatheringExperienceModule::LoadCohortData(GatheringSnapshot& data)
+{
+    // All-profession rows (profession 0) come first, specific ones override them
+    QueryResult result = WorldDatabase.Query("SELECT cohort_id, profession, multiplier FROM gathering_experience_cohorts ORDER BY profession");
+    if (!result)
+        return;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        uint8 cohort = fields[0].Get<uint8>();
+        uint8 profession = fields[1].Get<uint8>();
+        float multiplier = fields[2].Get<float>();
+
+        if (cohort >= GATHERING_MAX_COHORTS || profession > PROF_FISHING || multiplier < 0.0f)
+        {
+            LOG_ERROR("module", "Skipping gathering cohort {} profession {}: cohort ids go up to {}, professions up to {}",
+                cohort, profession, GATHERING_MAX_COHORTS - 1, PROF_FISHING);
+            continue;
+        }
+
+        if (cohort >= data.cohortMultipliers.size())
+            data.cohortMultipliers.resize(cohort + 1, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+        if (profession)
+            data.cohortMultipliers[cohort][profession - 1] = multiplier;
+        else
+            data.cohortMultipliers[cohort].fill(multiplier);
+    } while (result->NextRow());
+
+    LOG_INFO("module", "Loaded {} XP experiment cohorts", data.cohortMultipliers.size());
+}
+
+void GatheringExperienceModule::LoadItemZoneData(GatheringSnapshot& data)
+{
+    QueryResult result = WorldDatabase.Query("SELECT item_id, zone_id FROM gathering_experience_item_zones ORDER BY item_id, zone_id");
+    if (!result)
+        return;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        uint32 itemId = fields[0].Get<uint32>();
+        uint32 zoneId = fields[1].Get<uint32>();
+
+        if (zoneId >= GatheringZoneMatrix::ZONE_ID_LIMIT)
+        {
+            LOG_ERROR("module", "Skipping gathering zone {} of item {}: zone ids go up to {}",
+                zoneId, itemId, GatheringZoneMatrix::ZONE_ID_LIMIT - 1);
+            continue;
+        }
+
+        data.itemZones.emplace_back(itemId, zoneId);
+    } while (result->NextRow());
+
+    LOG_INFO("module", "Loaded {} gathering item zones", data.itemZones.size());
+}
+
 bool GatheringExperienceModule::ToggleMining()
 {
     miningEnabled = !miningEnabled;
@@ -139,84 +383,137 @@ bool GatheringExperienceModule::ToggleFishing()
 
 float GatheringExperienceModule::GetZoneMultiplier(uint32 zoneId) const
 {
-    auto it = zoneMultipliers.find(zoneId);
-    if (it != zoneMultipliers.end())
+    return GatheringFormula::GetZoneMultiplier(*GetSnapshot(), zoneId);
+}
+
+void GatheringExperienceModule::OnLootItem(Player* player, Item* item, uint32 count, ObjectGuid lootguid)
+{
+    GE_PROFILE_SCOPE("OnLootItem");
+
+    if (!enabled || !player || !item)
+        return;
+
+    // The only lookup of the item; everything below gets the pinned
+    // snapshot and the entry. Non-gathering items stop at the bit test.
+    uint32 itemId = item->GetEntry();
+    auto data = GetSnapshotFor(itemId);
+    GatheringItem const* entry = data ? data->items.Find(itemId) : nullptr;
+    uint8 profession = entry && entry->profession >= PROF_MINING && entry->profession <= PROF_FISHING ? entry->profession : 0;
+    sGatheringMetrics->OnLoot(profession);
+
+    // Node mode scores these in OnUpdateGatheringSkill instead
+    if (nodeMode && profession != PROF_FISHING)
+        return;
+
+    uint32 xpGained = 0;
+    switch (profession)
     {
-        return it->second;
+        case PROF_FISHING:
+            xpGained = sFishingExperience->CalculateFishingExperience(player, *data, itemId, *entry);
+            break;
+        case PROF_SKINNING:
+            xpGained = sSkinningExperience->CalculateSkinningExperience(player, *data, itemId, *entry);
+            break;
+        case PROF_HERBALISM:
+            xpGained = sHerbalismExperience->CalculateHerbalismExperience(player, *data, itemId, *entry);
+            break;
+        case PROF_MINING:
+            xpGained = sMiningExperience->CalculateMiningExperience(player, *data, itemId, *entry);
+            break;
+        default:
+            return;
     }
-    return 1.0f; // Default multiplier if zone not found
+
+    AwardExperience(player, *data, itemId, *entry, count, xpGained, lootguid);
 }
 
-uint32 GatheringExperienceModule::CalculateExperience(Player* player, uint32 baseXP, uint32 requiredSkill, uint32 currentSkill, uint32 /*itemId*/)
+void GatheringExperienceModule::OnUpdateGatheringSkill(Player* player, uint32 skillId, uint32 current, uint32 gray, uint32 green, uint32 yellow, uint32& /*gain*/)
 {
-    if (!player || !enabled)
-        return 0;
-
-    uint32 playerLevel = player->GetLevel();
-    if (playerLevel >= GATHERING_MAX_LEVEL)
-        return 0;
+    GE_PROFILE_SCOPE("OnUpdateGatheringSkill");
 
-    // Check skill requirement
-    if (currentSkill < requiredSkill)
-        return 0;
+    if (!enabled || !nodeMode || !player)
+        return;
 
-    // Get zone multiplier
-    float zoneMultiplier = 1.0f;
-    auto zoneIt = zoneMultipliers.find(player->GetZoneId());
-    if (zoneIt != zoneMultipliers.end())
+    uint8 profession = 0;
+    switch (skillId)
     {
-        zoneMultiplier = zoneIt->second;
+        case SKILL_MINING:
+            profession = miningEnabled ? PROF_MINING : 0;
+            break;
+        case SKILL_HERBALISM:
+            profession = herbalismEnabled ? PROF_HERBALISM : 0;
+            break;
+        case SKILL_SKINNING:
+            profession = skinningEnabled ? PROF_SKINNING : 0;
+            break;
+        default:
+            break;
     }
 
-    // Calculate progress bonus
-    float progressBonus = CalculateProgressBonus(currentSkill);
+    if (!profession)
+        return;
 
-    // Calculate final experience
-    uint32 experience = static_cast<uint32>(baseXP * (1.0f + progressBonus) * zoneMultiplier);
+    // Gathering colors start 25/50/100 points above the node's requirement
+    uint32 nodeSkill = yellow > 25 ? yellow - 25 : 0;
+
+    auto data = GetSnapshot();
+    uint32 itemId = data->FindNodeItem(profession, nodeSkill);
+    GatheringItem const* item = itemId ? data->items.Find(itemId) : nullptr;
+    if (!item)
+        return;
 
-    // Apply min/max bounds
-    experience = std::max(MIN_EXPERIENCE_GAIN, std::min(experience, MAX_EXPERIENCE_GAIN));
+    GatheringXPInput input;
+    input.level = player->GetLevel();
+    input.skill = current;
+    input.zoneMultiplier = 1.0f;
 
-    return experience;
+    GatheringXPResult result = GatheringFormula::Compute(*item, input);
+    float colorFactor = GatheringFormula::GetNodeColorFactor(current, gray, green, yellow);
+    uint32 xpGained = static_cast<uint32>(result.finalXP * colorFactor);
+
+    LOG_DEBUG("module", "Node XP for {}: skill {} node {} scored as {} (Item ID: {}), color factor {}, XP {}",
+        player->GetName(), current, nodeSkill, data->items.GetName(*item), itemId, colorFactor, xpGained);
+
+    // No loot guid here, every call is one harvested node
+    AwardExperience(player, *data, itemId, *item, 1, xpGained, ObjectGuid::Empty, colorFactor);
 }
 
-float GatheringExperienceModule::CalculateProgressBonus(uint32 currentSkill)
+uint32 GatheringExperienceModule::GetProfessionSkill(uint8 profession)
 {
-    uint32 currentTier = (currentSkill / TIER_SIZE) * TIER_SIZE;
-    uint32 progressInTier = currentSkill - currentTier;
-    return progressInTier * PROGRESS_BONUS_RATE;
+    switch (profession)
+    {
+        case PROF_MINING:    return SKILL_MINING;
+        case PROF_HERBALISM: return SKILL_HERBALISM;
+        case PROF_SKINNING:  return SKILL_SKINNING;
+        case PROF_FISHING:   return SKILL_FISHING;
+        default:             return 0;
+    }
 }
 
-void GatheringExperienceModule::OnLootItem(Player* player, Item* item, [[maybe_unused]] uint32 count, [[maybe_unused]] ObjectGuid lootguid)
+void GatheringExperienceModule::AwardExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item, uint32 count, uint32 xpGained, ObjectGuid lootguid, float nodeFactor)
 {
-    if (!enabled || !player || !item)
-        return;
-
-    uint32 itemId = item->GetEntry();
-    uint32 xpGained = 0;
+    GatheringGatherer gatherer;
+    gatherer.guid = player->GetGUID();
+    gatherer.data = GatheringPlayerData::Get(player);
+    gatherer.level = player->GetLevel();
+    gatherer.skill = player->GetSkillValue(GetProfessionSkill(item.profession));
+    gatherer.zoneId = player->GetZoneId();
+    gatherer.x = player->GetPositionX();
+    gatherer.y = player->GetPositionY();
+
+    if (uint32 xp = sGatheringScorer->Score(gatherer, data, itemId, item, count, xpGained, lootguid, nodeFactor))
+        player->GiveXP(xp, nullptr);
+}
 
-    // Check each profession
-    if (sFishingExperience->IsFishingItem(itemId))
-    {
-        xpGained = sFishingExperience->CalculateFishingExperience(player, itemId);
-    }
-    else if (sSkinningExperience->IsSkinningItem(itemId))
-    {
-        xpGained = sSkinningExperience->CalculateSkinningExperience(player, itemId);
-    }
-    else if (sHerbalismExperience->IsHerbalismItem(itemId))
-    {
-        xpGained = sHerbalismExperience->CalculateHerbalismExperience(player, itemId);
-    }
-    else if (sMiningExperience->IsMiningItem(itemId))
-    {
-        xpGained = sMiningExperience->CalculateMiningExperience(player, itemId);
-    }
+uint8 GatheringExperienceModule::GetItemProfession(uint32 itemId) const
+{
+    // Non-gathering items fail the table's bit test without pinning the snapshot
+    auto data = GetSnapshotFor(itemId);
+    GatheringItem const* item = data ? data->items.Find(itemId) : nullptr;
+    if (!item || item->profession < PROF_MINING || item->profession > PROF_FISHING)
+        return 0;
 
-    if (xpGained > 0)
-    {
-        player->GiveXP(xpGained, nullptr);
-    }
+    return item->profession;
 }
 
 void GatheringExperienceModule::SaveSettingToDB(std::string const& profession, bool enabled)
@@ -224,17 +521,29 @@ void GatheringExperienceModule::SaveSettingToDB(std::string const& profession, b
     WorldDatabase.DirectExecute(
         "REPLACE INTO gathering_experience_settings (profession, enabled) VALUES ('{}', {})",
         profession, enabled ? 1 : 0);
+    sGatheringSync->LogChange(GATHERING_CHANGE_SETTING);
 }
 
 void GatheringExperienceModule::OnStartup()
 {
     LOG_INFO("server.loading", "GatheringExperienceModule - Loading data from database...");
     LoadDataFromDB();
+
+    if (enabled)
+        sGatheringLeaderboard->LoadFromDB();
+}
+
+void GatheringExperienceModule::OnShutdown()
+{
+    sGatheringStress->Stop();
+    sGatheringMetrics->Stop();
+    sGatheringHeatmap->Flush();
 }
 
 void GatheringExperienceModule::OnBeforeConfigLoad(bool /*reload*/)
 {
     enabled = sConfigMgr->GetOption<bool>("GatheringExperience.Enable", true);
+    dataDirectory = sConfigMgr->GetOption<std::string>("DataDir", "./") + "/gathering_experience/";
     if (!enabled)
     {
         LOG_INFO("server.loading", "Gathering Experience Module is disabled by config.");
@@ -247,6 +556,29 @@ void GatheringExperienceModule::OnBeforeConfigLoad(bool /*reload*/)
     skinningEnabled = sConfigMgr->GetOption<bool>("GatheringExperience.Skinning.Enable", true);
     fishingEnabled = sConfigMgr->GetOption<bool>("GatheringExperience.Fishing.Enable", true);
 
+    // Snapshot cache, defaults to a file under the server data directory
+    cacheEnabled = sConfigMgr->GetOption<bool>("GatheringExperience.Cache.Enable", true);
+    cachePath = sConfigMgr->GetOption<std::string>("GatheringExperience.Cache.File", "");
+    if (cachePath.empty())
+        cachePath = dataDirectory + "snapshot.bin";
+
+    nodeMode = sConfigMgr->GetOption<bool>("GatheringExperience.NodeMode", false);
+
+    sGatheringMetrics->Configure(sConfigMgr->GetOption<std::string>("GatheringExperience.Metrics.File", ""),
+        sConfigMgr->GetOption<uint32>("GatheringExperience.Metrics.Interval", 15));
+
+    sGatheringScorer->LoadConfig();
+    sGatheringAntiBot->LoadConfig();
+    sGatheringSync->LoadConfig();
+    sGatheringTasks->LoadConfig();
+    sGatheringHeatmap->LoadConfig();
+    sGatheringCaps->LoadConfig();
+    sGatheringNotify->LoadConfig();
+    sGatheringStress->LoadConfig();
+    sGatheringCapture->Configure(sConfigMgr->GetOption<std::string>("GatheringExperience.Capture.File", ""),
+        sConfigMgr->GetOption<uint32>("GatheringExperience.Capture.Records", 1048576));
+    sGatheringLeaderboard->SetSize(sConfigMgr->GetOption<uint32>("GatheringExperience.Leaderboard.Size", 10));
+
     // Override with DB values if they exist
     LoadSettingsFromDB();
 
@@ -267,11 +599,27 @@ void GatheringExperienceModule::OnAfterConfigLoad(bool /*reload*/)
     }
 }
 
+void GatheringExperienceModule::OnUpdate(uint32 diff)
+{
+    ReleaseRetiredSnapshots();
+    GatheringPlayerData::ProcessLoads();
+    sGatheringLeaderboard->ProcessRefills();
+    sGatheringAntiBot->SendReports();
+    sGatheringEvents->Update();
+    sGatheringSync->Update(diff);
+    sGatheringTasks->Update();
+    sGatheringHeatmap->Update(diff);
+    sGatheringCaps->Update();
+    sGatheringNotify->Update();
+}
+
 void GatheringExperienceModule::OnLogin(Player* player)
 {
     if (!enabled)
         return;
 
+    GatheringPlayerData::Load(player);
+
     if (sConfigMgr->GetOption<bool>("GatheringExperience.Announce", true))
     {
         std::string message = "This server is running the |cff4CFF00Gathering Experience|r module v" + 
@@ -279,3 +627,23 @@ void GatheringExperienceModule::OnLogin(Player* player)
         ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
     }
 }
+
+void GatheringExperienceModule::OnSave(Player* player)
+{
+    sGatheringStats->SavePlayerStats(player);
+    sGatheringCaps->SavePlayerXP(player);
+}
+
+void GatheringExperienceModule::OnLogout(Player* player)
+{
+    sGatheringStats->SavePlayerStats(player);
+    sGatheringCaps->SavePlayerXP(player);
+}
+
+void GatheringExperienceModule::OnDelete(ObjectGuid guid, uint32 /*accountId*/)
+{
+    sGatheringStats->DeleteCharacterStats(guid);
+    sGatheringRates->DeleteCharacterRate(guid);
+    sGatheringCaps->DeleteCharacterXP(guid);
+    sGatheringNotify->DeleteCharacterPreferences(guid);
+}
@@ -8,46 +8,29 @@
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "StringFormat.h"
+#include "engine/GatheringFormula.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
 
-// Constants
-const uint32 GATHERING_MAX_LEVEL = 80;
-const uint32 MAX_EXPERIENCE_GAIN = 5000;
-const uint32 MIN_EXPERIENCE_GAIN = 10;
 extern const char* GATHERING_EXPERIENCE_VERSION;
 
-enum GatheringProfessions
-{
-    PROF_MINING     = 1,
-    PROF_HERBALISM  = 2,
-    PROF_SKINNING   = 3,
-    PROF_FISHING    = 4
-};
-
 class GatheringExperienceModule : public PlayerScript, public WorldScript
 {
 private:
-    // Constants for better readability and maintenance
-    static constexpr uint32 TIER_SIZE = 75;
-    static constexpr float PROGRESS_BONUS_RATE = 0.02f;
-    static constexpr float BASE_ZONE_MULTIPLIER = 1.0f;
-
-    // Skill tier thresholds
-    static constexpr uint32 TIER_1_MAX = 75;
-    static constexpr uint32 TIER_2_MAX = 150;
-    static constexpr uint32 TIER_3_MAX = 225;
-    static constexpr uint32 TIER_4_MAX = 300;
-
-    struct GatheringItem {
-        uint32 baseXP;
-        uint32 requiredSkill;
-        uint8 profession;
-        std::string name;
-        uint8 rarity;
-    };
-
-    std::map<uint32, GatheringItem> gatheringItems;
-    std::map<uint32, float> zoneMultipliers;
-    std::map<uint32, float> rarityMultipliers;
+    std::shared_ptr<GatheringSnapshot const> snapshot{std::make_shared<GatheringSnapshot>()};
+
+    // The same snapshot as a plain pointer, so loot of non-gathering items is
+    // rejected without the lock std::atomic_load takes on a shared_ptr
+    std::atomic<GatheringSnapshot const*> currentSnapshot{snapshot.get()};
+
+    // Replaced snapshots stay alive until a full world update has passed
+    // since, so a map thread still testing the plain pointer never reads
+    // freed memory
+    std::mutex publishLock;
+    std::vector<std::pair<std::shared_ptr<GatheringSnapshot const>, uint32>> retiredSnapshots; // Snapshot, update it was retired in
+    uint32 updateCount{0};
     bool enabled{false};
     bool dataLoaded{false};
 
@@ -56,6 +39,13 @@ private:
     bool skinningEnabled{true};
     bool fishingEnabled{true};
 
+    std::string dataDirectory;
+    bool cacheEnabled{true};
+    std::string cachePath;
+
+    // Score mining, herbalism and skinning once per node instead of per item
+    bool nodeMode{false};
+
 public:
     static GatheringExperienceModule* instance;
 
@@ -68,15 +58,42 @@ public:
 
     // Override functions
     void OnStartup();
+    void OnShutdown();
     void OnBeforeConfigLoad(bool reload);
     void OnLootItem(Player* player, Item* item, uint32 count, ObjectGuid lootguid);
     void OnAfterConfigLoad(bool reload);
+    void OnUpdate(uint32 diff);
     void OnLogin(Player* player);
+    void OnSave(Player* player);
+    void OnLogout(Player* player);
+    void OnDelete(ObjectGuid guid, uint32 accountId);
+    void OnUpdateGatheringSkill(Player* player, uint32 skillId, uint32 current, uint32 gray, uint32 green, uint32 yellow, uint32& gain);
 
     // Database loading
     void LoadDataFromDB();
     void LoadSettingsFromDB();
     void SaveSettingToDB(std::string const& profession, bool enabled);
+
+    // Re-reads only the given items, zones and settings into a new snapshot
+    void ApplyChanges(std::set<uint32> const& items, std::set<uint32> const& zones, bool settings);
+
+    // Directory for the module's own files (cache, imports, exports)
+    std::string const& GetDataDirectory() const { return dataDirectory; }
+
+    // Current data; the pointer stays valid for the caller even across a reload
+    std::shared_ptr<GatheringSnapshot const> GetSnapshot() const { return std::atomic_load(&snapshot); }
+
+    // Current data pinned only for items it may hold, nullptr for all other
+    // loot after a single bit test
+    std::shared_ptr<GatheringSnapshot const> GetSnapshotFor(uint32 itemId) const
+    {
+        if (!currentSnapshot.load(std::memory_order_acquire)->items.MayContain(itemId))
+            return nullptr;
+        return GetSnapshot();
+    }
+
+    // Publishes data only if current is still the live snapshot
+    bool ReplaceSnapshot(std::shared_ptr<GatheringSnapshot const> current, std::shared_ptr<GatheringSnapshot const> data);
     
     // Profession toggle functions
     bool ToggleMining();
@@ -90,41 +107,40 @@ public:
     bool IsSkinningEnabled() const { return skinningEnabled; }
     bool IsFishingEnabled() const { return fishingEnabled; }
     
-    // XP calculation functions
-    uint32 CalculateExperience(Player* player, uint32 baseXP, uint32 requiredSkill, uint32 currentSkill, uint32 itemId);
+    // XP calculation functions, the formulas themselves are in engine/
     float GetZoneMultiplier(uint32 zoneId) const;
+    static uint32 GetProfessionSkill(uint8 profession);
 
     bool IsEnabled() const { return enabled; }
+    bool IsNodeMode() const { return nodeMode; }
     void SetEnabled(bool state) { enabled = state; }
 
-    std::optional<std::tuple<uint32, uint32, uint8, std::string, uint8>> GetGatheringData(uint32 itemId) const
-    {
-        auto it = gatheringItems.find(itemId);
-        if (it != gatheringItems.end())
-        {
-            return std::make_tuple(
-                it->second.baseXP,
-                it->second.requiredSkill,
-                it->second.profession,
-                it->second.name,
-                it->second.rarity
-            );
-        }
-        return std::nullopt;
-    }
-
-    void LoadGatheringData();
-
     bool IsGatheringItem(uint32 itemId) const
     {
-        return gatheringItems.find(itemId) != gatheringItems.end();
+        auto data = GetSnapshotFor(itemId);
+        return data && data->items.Find(itemId) != nullptr;
     }
 
+    // Profession an item gives XP for, 0 if none
+    uint8 GetItemProfession(uint32 itemId) const;
+
 private:
-    // Helper functions
-    float GetFishingTierMultiplier(uint32 currentSkill) const;
-    float CalculateProgressBonus(uint32 currentSkill);
-    void LoadZoneData();
+    // Scores a gather of player with sGatheringScorer and gives the XP
+    void AwardExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item, uint32 count, uint32 xpGained, ObjectGuid lootguid, float nodeFactor = 1.0f);
+
+    // Snapshot loaders, optionally restricted by a WHERE condition
+    void LoadSettingsData(GatheringSnapshot& data);
+    void LoadGatheringData(GatheringSnapshot& data, std::string const& filter = "");
+    void LoadZoneData(GatheringSnapshot& data, std::string const& filter = "");
+    void LoadRarityData(GatheringSnapshot& data, std::string const& filter = "");
+    void LoadCohortData(GatheringSnapshot& data);
+    void LoadItemZoneData(GatheringSnapshot& data);
+    void ApplySettings(GatheringSnapshot const& data);
+    uint64 QueryTableChecksum();
+
+    // Makes data the live snapshot and retires the previous one
+    void PublishSnapshot(std::shared_ptr<GatheringSnapshot const> data);
+    void ReleaseRetiredSnapshots();
 };
 
 #define sGatheringExperience GatheringExperienceModule::instance
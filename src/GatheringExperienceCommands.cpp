@@ -6,6 +6,26 @@
 #include "Chat.h"
 #include "Config.h"
 #include "GatheringExperience.h"
+#include "GatheringStats.h"
+#include "GatheringLeaderboard.h"
+#include "GatheringGolden.h"
+#include "GatheringImport.h"
+#include "GatheringProfiler.h"
+#include "GatheringStress.h"
+#include "GatheringEvents.h"
+#include "GatheringRates.h"
+#include "GatheringSync.h"
+#include "GatheringTasks.h"
+#include "GatheringCapture.h"
+#include "GatheringMetrics.h"
+#include "GatheringHeatmap.h"
+#include "GatheringCaps.h"
+#include "GatheringNotify.h"
+#include "GatheringScorer.h"
+#include "Common.h"
+#include "GameTime.h"
+#include <filesystem>
+#include <fstream>
 
 using namespace Acore::ChatCommands;
 
@@ -29,6 +49,19 @@ public:
             { "currentzone", HandleGatheringCurrentZoneCommand,          SEC_GAMEMASTER,  Console::No  },
             { "toggle",      HandleGatheringToggleProfessionCommand,     SEC_GAMEMASTER,  Console::Yes },
             { "status",      HandleGatheringStatusCommand,               SEC_GAMEMASTER,  Console::Yes },
+            { "import",      HandleGatheringImportCommand,               SEC_ADMINISTRATOR, Console::Yes },
+            { "export",      HandleGatheringExportCommand,               SEC_ADMINISTRATOR, Console::Yes },
+            { "mystats",     HandleGatheringMyStatsCommand,              SEC_PLAYER,      Console::No  },
+            { "notify",      HandleGatheringNotifyCommand,               SEC_PLAYER,      Console::No  },
+            { "top",         HandleGatheringTopCommand,                  SEC_PLAYER,      Console::Yes },
+            { "golden",      HandleGatheringGoldenCommand,               SEC_ADMINISTRATOR, Console::Yes },
+            { "profile",     HandleGatheringProfileCommand,              SEC_ADMINISTRATOR, Console::Yes },
+            { "stress",      HandleGatheringStressCommand,               SEC_ADMINISTRATOR, Console::Yes },
+            { "events",      HandleGatheringEventsCommand,               SEC_GAMEMASTER,  Console::Yes },
+            { "rate",        HandleGatheringRateCommand,                 SEC_GAMEMASTER,  Console::No  },
+            { "replay",      HandleGatheringReplayCommand,               SEC_ADMINISTRATOR, Console::Yes },
+            { "cohorts",     HandleGatheringCohortsCommand,              SEC_GAMEMASTER,  Console::Yes },
+            { "heatmap",     HandleGatheringHeatmapCommand,              SEC_GAMEMASTER,  Console::Yes },
         };
 
         static ChatCommandTable commandTable =
@@ -41,12 +74,16 @@ public:
 
     static bool HandleGatheringVersionCommand(ChatHandler* handler, const char* /*args*/)
     {
+        GE_PROFILE_SCOPE("HandleGatheringVersionCommand");
+
         handler->PSendSysMessage("Gathering Experience Module Version: {}", GATHERING_EXPERIENCE_VERSION);
         return true;
     }
 
     static bool HandleGatheringReloadCommand(ChatHandler* handler, const char* /*args*/)
     {
+        GE_PROFILE_SCOPE("HandleGatheringReloadCommand");
+
         LOG_INFO("server.loading", "Manual reload command triggered");
         if (!GatheringExperienceModule::instance)
         {
@@ -54,6 +91,7 @@ public:
             return false;
         }
 
+        sGatheringSync->LogChange(GATHERING_CHANGE_RELOAD);
         GatheringExperienceModule::instance->LoadDataFromDB();
         handler->PSendSysMessage("Gathering Experience data reloaded from database.");
         return true;
@@ -61,6 +99,8 @@ public:
 
     static bool HandleGatheringAddCommand(ChatHandler* handler, char const* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringAddCommand");
+
         if (!*args)
         {
             handler->SendSysMessage("Usage: .gathering add #itemId #baseXP #requiredSkill #profession \"name\"");
@@ -112,21 +152,24 @@ public:
             "INSERT INTO gathering_experience (item_id, base_xp, required_skill, profession, name) "
             "VALUES ({}, {}, {}, {}, '{}')",
             itemId, baseXP, requiredSkill, profession, escapedName);
+        sGatheringSync->LogChange(GATHERING_CHANGE_ITEM, itemId);
 
-        // Force reload of data after adding
+        // Re-read just this item
         if (!GatheringExperienceModule::instance)
         {
             handler->PSendSysMessage("Failed to reload data after adding item {}.", itemId);
             return false;
         }
 
-        GatheringExperienceModule::instance->LoadDataFromDB();
+        GatheringExperienceModule::instance->ApplyChanges({ itemId }, {}, false);
         handler->PSendSysMessage("Added gathering experience entry for item {}.", itemId);
         return true;
     }
 
     static bool HandleGatheringRemoveCommand(ChatHandler* handler, const char* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringRemoveCommand");
+
         char* itemIdStr = strtok((char*)args, " ");
         if (!itemIdStr)
         {
@@ -151,25 +194,28 @@ public:
         WorldDatabase.DirectExecute(
             "DELETE FROM gathering_experience_rarity WHERE item_id = {}", 
             itemId);
+        sGatheringSync->LogChange(GATHERING_CHANGE_ITEM, itemId);
 
-        // Force reload of data after removing
+        // Re-read just this item, dropping it
         if (!GatheringExperienceModule::instance)
         {
             handler->PSendSysMessage("Failed to reload data after removing item {}.", itemId);
             return false;
         }
 
-        GatheringExperienceModule::instance->LoadDataFromDB();
+        GatheringExperienceModule::instance->ApplyChanges({ itemId }, {}, false);
         handler->PSendSysMessage("Removed gathering item {} and reloaded data.", itemId);
         return true;
     }
 
     static bool HandleGatheringModifyCommand(ChatHandler* handler, char const* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringModifyCommand");
+
         if (!*args)
         {
             handler->SendSysMessage("Usage: .gathering modify <itemId> <field> <value>");
-            handler->SendSysMessage("Fields: basexp, reqskill, profession, multiplier, name");
+            handler->SendSysMessage("Fields: basexp, reqskill, reclevel, profession, multiplier, name");
             return true;
         }
 
@@ -179,7 +225,7 @@ public:
         if (!itemIdStr || !fieldStr)
         {
             handler->SendSysMessage("Usage: .gathering modify <itemId> <field> <value>");
-            handler->SendSysMessage("Fields: basexp, reqskill, profession, multiplier, name");
+            handler->SendSysMessage("Fields: basexp, reqskill, reclevel, profession, multiplier, name");
             return false;
         }
 
@@ -233,6 +279,15 @@ public:
             {
                 query += Acore::StringFormat("required_skill = {}", atoi(value.c_str()));
             }
+            else if (field == "reclevel")
+            {
+                // 0 clears the override so the level is derived from base XP again
+                uint32 recommendedLevel = atoi(value.c_str());
+                if (recommendedLevel == 0)
+                    query += "recommended_level = NULL";
+                else
+                    query += Acore::StringFormat("recommended_level = {}", std::min(recommendedLevel, GATHERING_MAX_LEVEL));
+            }
             else if (field == "profession")
             {
                 uint8 professionId = GetProfessionIdByName(value);
@@ -266,15 +321,16 @@ public:
                         "REPLACE INTO gathering_experience_rarity (item_id, multiplier) VALUES ({}, {})",
                         itemId, multiplier);
                 }
+                sGatheringSync->LogChange(GATHERING_CHANGE_ITEM, itemId);
 
-                // Force reload of data after modification
+                // Re-read just this item
                 if (!GatheringExperienceModule::instance)
                 {
                     handler->PSendSysMessage("Failed to reload data after modifying item {}.", itemId);
                     return false;
                 }
 
-                GatheringExperienceModule::instance->LoadDataFromDB();
+                GatheringExperienceModule::instance->ApplyChanges({ itemId }, {}, false);
 
                 // Show updated values
                 QueryResult result = WorldDatabase.Query(
@@ -302,24 +358,25 @@ public:
             else
             {
                 handler->SendSysMessage("Invalid field specified.");
-                handler->SendSysMessage("Valid fields: basexp, reqskill, profession, multiplier, name");
+                handler->SendSysMessage("Valid fields: basexp, reqskill, reclevel, profession, multiplier, name");
                 return false;
             }
         }
 
         query += Acore::StringFormat(" WHERE item_id = {}", itemId);
         WorldDatabase.DirectExecute(query);
+        sGatheringSync->LogChange(GATHERING_CHANGE_ITEM, itemId);
         
-        // Force reload of data after modification
+        // Re-read just this item
         if (!GatheringExperienceModule::instance)
         {
             handler->PSendSysMessage("Failed to reload data after modifying item {}.", itemId);
             return false;
         }
 
-        GatheringExperienceModule::instance->LoadDataFromDB();
+        GatheringExperienceModule::instance->ApplyChanges({ itemId }, {}, false);
         
-        // Show updated item details AFTER reload
+        // Show updated item details
         QueryResult result = WorldDatabase.Query(
             "SELECT ge.item_id, ge.base_xp, ge.required_skill, gep.name as prof_name, COALESCE(ger.multiplier, 1.0) as multiplier, ge.name "
             "FROM gathering_experience ge "
@@ -344,34 +401,28 @@ public:
 
     static bool HandleGatheringListCommand(ChatHandler* handler, char const* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringListCommand");
+
         if (!*args)
         {
             // List all items
-            QueryResult result = WorldDatabase.Query(
+            sGatheringTasks->Start(handler, std::make_unique<GatheringQueryTask>(
                 "SELECT ge.item_id, ge.base_xp, ge.required_skill, gep.name as prof_name, COALESCE(ger.multiplier, 1.0) as multiplier, ge.name "
                 "FROM gathering_experience ge "
                 "JOIN gathering_experience_professions gep ON ge.profession = gep.profession_id "
                 "LEFT JOIN gathering_experience_rarity ger ON ge.item_id = ger.item_id "
-                "ORDER BY gep.name, ge.required_skill");
-
-            if (!result)
-            {
-                handler->SendSysMessage("No gathering items found.");
-                return true;
-            }
-
-            handler->SendSysMessage("Current gathering items:");
-            do
-            {
-                Field* fields = result->Fetch();
-                handler->PSendSysMessage("ItemID: {}, BaseXP: {}, ReqSkill: {}, Profession: {}, Multiplier: {:.2f}, Name: {}",
-                    fields[0].Get<uint32>(),    // ItemID
-                    fields[1].Get<uint32>(),    // BaseXP
-                    fields[2].Get<uint32>(),    // ReqSkill
-                    fields[3].Get<std::string>(), // Profession name
-                    fields[4].Get<float>(),    // Multiplier
-                    fields[5].Get<std::string>()); // Item name
-            } while (result->NextRow());
+                "ORDER BY gep.name, ge.required_skill",
+                "Current gathering items:", "No gathering items found.",
+                [](ChatHandler* output, Field* fields)
+                {
+                    output->PSendSysMessage("ItemID: {}, BaseXP: {}, ReqSkill: {}, Profession: {}, Multiplier: {:.2f}, Name: {}",
+                        fields[0].Get<uint32>(),    // ItemID
+                        fields[1].Get<uint32>(),    // BaseXP
+                        fields[2].Get<uint32>(),    // ReqSkill
+                        fields[3].Get<std::string>(), // Profession name
+                        fields[4].Get<float>(),    // Multiplier
+                        fields[5].Get<std::string>()); // Item name
+                }));
         }
         else
         {
@@ -379,32 +430,26 @@ public:
             std::string profName = args;
             // Convert to lowercase for case-insensitive comparison
             std::transform(profName.begin(), profName.end(), profName.begin(), ::tolower);
+            WorldDatabase.EscapeString(profName);
 
-            QueryResult result = WorldDatabase.Query(
+            sGatheringTasks->Start(handler, std::make_unique<GatheringQueryTask>(Acore::StringFormat(
                 "SELECT ge.item_id, ge.base_xp, ge.required_skill, gep.name as prof_name, COALESCE(ger.multiplier, 1.0) as multiplier, ge.name "
                 "FROM gathering_experience ge "
                 "JOIN gathering_experience_professions gep ON ge.profession = gep.profession_id "
                 "LEFT JOIN gathering_experience_rarity ger ON ge.item_id = ger.item_id "
                 "WHERE LOWER(gep.name) = '{}' "
-                "ORDER BY ge.required_skill", profName);
-
-            if (!result)
-            {
-                handler->PSendSysMessage("No gathering items found for profession: {}", args);
-                return true;
-            }
-
-            handler->PSendSysMessage("Current gathering items for {}:", args);
-            do
-            {
-                Field* fields = result->Fetch();
-                handler->PSendSysMessage("ItemID: {}, BaseXP: {}, ReqSkill: {}, Multiplier: {:.2f}, Name: {}",
-                    fields[0].Get<uint32>(),    // ItemID
-                    fields[1].Get<uint32>(),    // BaseXP
-                    fields[2].Get<uint32>(),    // ReqSkill
-                    fields[4].Get<float>(),    // Multiplier
-                    fields[5].Get<std::string>()); // Item name
-            } while (result->NextRow());
+                "ORDER BY ge.required_skill", profName),
+                Acore::StringFormat("Current gathering items for {}:", args),
+                Acore::StringFormat("No gathering items found for profession: {}", args),
+                [](ChatHandler* output, Field* fields)
+                {
+                    output->PSendSysMessage("ItemID: {}, BaseXP: {}, ReqSkill: {}, Multiplier: {:.2f}, Name: {}",
+                        fields[0].Get<uint32>(),    // ItemID
+                        fields[1].Get<uint32>(),    // BaseXP
+                        fields[2].Get<uint32>(),    // ReqSkill
+                        fields[4].Get<float>(),    // Multiplier
+                        fields[5].Get<std::string>()); // Item name
+                }));
         }
 
         return true;
@@ -430,6 +475,8 @@ public:
 
     static bool HandleGatheringHelpCommand(ChatHandler* handler, const char* /*args*/)
     {
+        GE_PROFILE_SCOPE("HandleGatheringHelpCommand");
+
         handler->SendSysMessage("Gathering Experience Module Commands:");
         handler->SendSysMessage("  .gathering version - Shows module version");
         handler->SendSysMessage("  .gathering reload - Reloads data from database");
@@ -441,12 +488,27 @@ public:
         handler->SendSysMessage("  .gathering currentzone");
         handler->SendSysMessage("  .gathering toggle <profession>");
         handler->SendSysMessage("  .gathering status");
-        handler->SendSysMessage("Fields for modify: basexp, reqskill, profession, multiplier, name");
+        handler->SendSysMessage("  .gathering import <file>");
+        handler->SendSysMessage("  .gathering export <file>");
+        handler->SendSysMessage("  .gathering mystats");
+        handler->SendSysMessage("  .gathering notify [on|off]");
+        handler->SendSysMessage("  .gathering top <profession> [count]");
+        handler->SendSysMessage("  .gathering golden <write|check> [file] [seed]");
+        handler->SendSysMessage("  .gathering profile <dump|clear> [file]");
+        handler->SendSysMessage("  .gathering stress [threads] [events] [players] [gatherms] [editms] - Loot path load test");
+        handler->SendSysMessage("  .gathering events - Lists active and upcoming XP events");
+        handler->SendSysMessage("  .gathering rate [account|character] [multiplier|reset] - XP rate of the selected player");
+        handler->SendSysMessage("  .gathering replay <file> - Replays a loot capture through the current XP formulas");
+        handler->SendSysMessage("  .gathering cohorts [reset] - XP experiment cohorts and their gathers and XP");
+        handler->SendSysMessage("  .gathering heatmap [zoneId] [count] - Map cells with the most gathers in a zone");
+        handler->SendSysMessage("Fields for modify: basexp, reqskill, reclevel, profession, multiplier, name");
         return true;
     }
 
     static bool HandleGatheringZoneCommand(ChatHandler* handler, const char* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringZoneCommand");
+
         if (!args || !*args)
         {
             handler->SendSysMessage("Usage:");
@@ -468,23 +530,16 @@ public:
 
         if (action == "list")
         {
-            QueryResult result = WorldDatabase.Query(
-                "SELECT zone_id, multiplier, name FROM gathering_experience_zones ORDER BY zone_id");
-            if (!result)
-            {
-                handler->SendSysMessage("No zone multipliers found.");
-                return true;
-            }
-
-            handler->SendSysMessage("Current zone multipliers:");
-            do
-            {
-                Field* fields = result->Fetch();
-                handler->PSendSysMessage("Zone: {} (ID: {}), Multiplier: {:.2f}x", 
-                    fields[2].Get<std::string>(),  // name
-                    fields[0].Get<uint32>(),       // zone_id
-                    fields[1].Get<float>());       // multiplier
-            } while (result->NextRow());
+            sGatheringTasks->Start(handler, std::make_unique<GatheringQueryTask>(
+                "SELECT zone_id, multiplier, name FROM gathering_experience_zones ORDER BY zone_id",
+                "Current zone multipliers:", "No zone multipliers found.",
+                [](ChatHandler* output, Field* fields)
+                {
+                    output->PSendSysMessage("Zone: {} (ID: {}), Multiplier: {:.2f}x",
+                        fields[2].Get<std::string>(),  // name
+                        fields[0].Get<uint32>(),       // zone_id
+                        fields[1].Get<float>());       // multiplier
+                }));
             return true;
         }
 
@@ -591,16 +646,20 @@ public:
             return false;
         }
 
-        // Reload data
+        sGatheringSync->LogChange(GATHERING_CHANGE_ZONE, zoneId);
+
+        // Re-read just this zone
         if (GatheringExperienceModule::instance)
         {
-            GatheringExperienceModule::instance->LoadDataFromDB();
+            GatheringExperienceModule::instance->ApplyChanges({}, { zoneId }, false);
         }
         return true;
     }
 
     static bool HandleGatheringCurrentZoneCommand(ChatHandler* handler, const char* /*args*/)
     {
+        GE_PROFILE_SCOPE("HandleGatheringCurrentZoneCommand");
+
         Player* player = handler->GetPlayer();
         if (!player)
         {
@@ -649,6 +708,8 @@ public:
 
     static bool HandleGatheringToggleProfessionCommand(ChatHandler* handler, const char* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringToggleProfessionCommand");
+
         if (!args)
         {
             handler->SendSysMessage("Usage: .gathering toggle <profession>");
@@ -698,6 +759,8 @@ public:
 
     static bool HandleGatheringStatusCommand(ChatHandler* handler, const char* /*args*/)
     {
+        GE_PROFILE_SCOPE("HandleGatheringStatusCommand");
+
         if (!GatheringExperienceModule::instance)
         {
             handler->PSendSysMessage("Module instance not found.");
@@ -709,11 +772,633 @@ public:
         handler->PSendSysMessage("Herbalism: {}", GatheringExperienceModule::instance->IsHerbalismEnabled() ? "Enabled" : "Disabled");
         handler->PSendSysMessage("Skinning: {}", GatheringExperienceModule::instance->IsSkinningEnabled() ? "Enabled" : "Disabled");
         handler->PSendSysMessage("Fishing: {}", GatheringExperienceModule::instance->IsFishingEnabled() ? "Enabled" : "Disabled");
+        handler->PSendSysMessage("Data version: {}", sGatheringSync->GetVersion());
+        return true;
+    }
+
+    // Resolves a file name inside the module data directory, rejecting anything outside it
+    static bool ResolveDataFile(ChatHandler* handler, char const* args, std::string const& command, std::string& path)
+    {
+        std::string fileName = args ? args : "";
+        while (!fileName.empty() && (fileName[0] == '"' || fileName[0] == ' '))
+            fileName = fileName.substr(1);
+        while (!fileName.empty() && (fileName.back() == '"' || fileName.back() == ' '))
+            fileName.pop_back();
+
+        if (fileName.empty())
+        {
+            handler->PSendSysMessage("Usage: .gathering {} <file>", command);
+            handler->PSendSysMessage("Files are read from and written to {}", GatheringExperienceModule::instance->GetDataDirectory());
+            return false;
+        }
+
+        if (std::filesystem::path(fileName).is_absolute() || fileName.find("..") != std::string::npos)
+        {
+            handler->PSendSysMessage("File must be a relative name inside {}", GatheringExperienceModule::instance->GetDataDirectory());
+            return false;
+        }
+
+        path = GatheringExperienceModule::instance->GetDataDirectory() + fileName;
+        return true;
+    }
+
+    static std::string QuoteCsv(std::string const& value)
+    {
+        std::string quoted = "\"";
+        for (char c : value)
+        {
+            if (c == '"')
+                quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    static bool HandleGatheringImportCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringImportCommand");
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        std::string path;
+        if (!ResolveDataFile(handler, args, "import", path))
+            return false;
+
+        // Parsed and committed over several world updates, see GatheringImportTask
+        sGatheringTasks->Start(handler, std::make_unique<GatheringImportTask>(path));
+        return true;
+    }
+
+    static bool HandleGatheringExportCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringExportCommand");
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        std::string path;
+        if (!ResolveDataFile(handler, args, "export", path))
+            return false;
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            handler->PSendSysMessage("Could not open {} for writing.", path);
+            return false;
+        }
+
+        out << "# item,item_id,base_xp,required_skill,profession,recommended_level,name\n";
+        out << "# zone,zone_id,multiplier,name\n";
+        out << "# rarity,item_id,multiplier\n";
+
+        uint32 items = 0, zones = 0, rarities = 0;
+
+        if (QueryResult result = WorldDatabase.Query(
+            "SELECT item_id, base_xp, required_skill, profession, recommended_level, name FROM gathering_experience ORDER BY item_id"))
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                out << Acore::StringFormat("item,{},{},{},{},{},{}\n",
+                    fields[0].Get<uint32>(),
+                    fields[1].Get<uint32>(),
+                    fields[2].Get<uint32>(),
+                    fields[3].Get<uint32>(),
+                    fields[4].IsNull() ? std::string() : std::to_string(fields[4].Get<uint32>()),
+                    QuoteCsv(fields[5].Get<std::string>()));
+                ++items;
+            } while (result->NextRow());
+        }
+
+        if (QueryResult result = WorldDatabase.Query(
+            "SELECT zone_id, multiplier, name FROM gathering_experience_zones ORDER BY zone_id"))
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                out << Acore::StringFormat("zone,{},{},{}\n",
+                    fields[0].Get<uint32>(), fields[1].Get<float>(), QuoteCsv(fields[2].Get<std::string>()));
+                ++zones;
+            } while (result->NextRow());
+        }
+
+        if (QueryResult result = WorldDatabase.Query(
+            "SELECT item_id, multiplier FROM gathering_experience_rarity ORDER BY item_id"))
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                out << Acore::StringFormat("rarity,{},{}\n", fields[0].Get<uint32>(), fields[1].Get<float>());
+                ++rarities;
+            } while (result->NextRow());
+        }
+
+        handler->PSendSysMessage("Exported {} items, {} zones and {} rarity multipliers to {}.", items, zones, rarities, path);
+        return true;
+    }
+
+    static bool HandleGatheringMyStatsCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringMyStatsCommand");
+
+        Player* target = handler->GetPlayer();
+        if (!target)
+        {
+            handler->SendSysMessage("This command can only be used in-game.");
+            return true;
+        }
+
+        // Game masters may look at their selected player instead
+        if (handler->GetSession()->GetSecurity() >= SEC_GAMEMASTER)
+            if (Player* selected = handler->getSelectedPlayer())
+                target = selected;
+
+        GatheringPlayerData* data = GatheringPlayerData::Get(target);
+        if (!data || !GatheringExperienceModule::instance)
+        {
+            handler->SendSysMessage("No gathering statistics available.");
+            return true;
+        }
+
+        static char const* const professionNames[GATHERING_PROFESSION_COUNT] = { "Mining", "Herbalism", "Skinning", "Fishing" };
+        auto snapshot = GatheringExperienceModule::instance->GetSnapshot();
+
+        handler->PSendSysMessage("Gathering statistics for {}:", target->GetName());
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        {
+            GatheringProfessionStats const& stats = data->stats[i];
+            if (!stats.gathers)
+            {
+                handler->PSendSysMessage("{}: nothing gathered yet", professionNames[i]);
+                continue;
+            }
+
+            GatheringItem const* item = snapshot->items.Find(stats.lastItemId);
+            std::string lastItem = item ? std::string(snapshot->items.GetName(*item)) : "Unknown";
+            handler->PSendSysMessage("{}: {} gathers, {} XP earned, last: {} (ID: {})",
+                professionNames[i], stats.gathers, stats.xpEarned, lastItem, stats.lastItemId);
+        }
+
+        if (sGatheringCaps->IsEnabled())
+        {
+            std::string today;
+            for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+                if (uint32 cap = sGatheringCaps->GetProfessionCap(i + 1))
+                    today += Acore::StringFormat(", {} {}/{}", professionNames[i], sGatheringCaps->GetProfessionXP(data, i + 1), cap);
+
+            uint32 totalCap = sGatheringCaps->GetTotalCap();
+            handler->PSendSysMessage("Today: {} XP{}{}", sGatheringCaps->GetTotalXP(data),
+                totalCap ? " of " + std::to_string(totalCap) : std::string(), today);
+        }
+        return true;
+    }
+
+    // In-memory profession lookup for player facing commands
+    static uint8 ParseProfession(std::string name)
+    {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == "mining")
+            return PROF_MINING;
+        if (name == "herbalism")
+            return PROF_HERBALISM;
+        if (name == "skinning")
+            return PROF_SKINNING;
+        if (name == "fishing")
+            return PROF_FISHING;
+        return 0;
+    }
+
+    static bool HandleGatheringNotifyCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringNotifyCommand");
+
+        Player* player = handler->GetPlayer();
+        GatheringPlayerData* data = player ? GatheringPlayerData::Get(player) : nullptr;
+        if (!data)
+        {
+            handler->SendSysMessage("This command can only be used in-game.");
+            return true;
+        }
+
+        // Without an argument it toggles
+        std::string mode = args ? args : "";
+        bool show;
+        if (mode.empty())
+            show = data->preferences.test(GATHERING_PREF_HIDE_XP);
+        else if (mode == "on")
+            show = true;
+        else if (mode == "off")
+            show = false;
+        else
+        {
+            handler->SendSysMessage("Usage: .gathering notify [on|off]");
+            return true;
+        }
+
+        sGatheringNotify->SetShowXP(player, show);
+        handler->PSendSysMessage("Gathering XP notifications {}.", show ? "enabled" : "disabled");
+        return true;
+    }
+
+    static bool HandleGatheringTopCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringTopCommand");
+
+        char* professionStr = args ? strtok((char*)args, " ") : nullptr;
+        char* countStr = strtok(nullptr, " ");
+
+        uint8 profession = professionStr ? ParseProfession(professionStr) : 0;
+        if (!profession)
+        {
+            handler->SendSysMessage("Usage: .gathering top <profession> [count]");
+            handler->SendSysMessage("Valid professions: mining, herbalism, skinning, fishing");
+            return true;
+        }
+
+        uint32 count = countStr ? atoi(countStr) : 0;
+        if (!count)
+            count = sGatheringLeaderboard->GetSize();
+        std::vector<GatheringLeaderboardEntry> entries = sGatheringLeaderboard->GetTop(profession, count);
+        if (entries.empty())
+        {
+            handler->PSendSysMessage("Nobody has gathered anything for {} yet.", professionStr);
+            return true;
+        }
+
+        handler->PSendSysMessage("Top {} gatherers for {}:", entries.size(), professionStr);
+        uint32 rank = 0;
+        for (GatheringLeaderboardEntry const& entry : entries)
+            handler->PSendSysMessage("{}. {} - {} gathers, {} XP", ++rank, entry.name, entry.gathers, entry.xpEarned);
+        return true;
+    }
+
+    static bool HandleGatheringGoldenCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringGoldenCommand");
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        char* actionStr = args ? strtok((char*)args, " ") : nullptr;
+        char* fileStr = strtok(nullptr, " ");
+        char* seedStr = strtok(nullptr, "\0");
+        std::string action = actionStr ? actionStr : "";
+
+        if (action != "write" && action != "check")
+        {
+            handler->SendSysMessage("Usage: .gathering golden <write|check> [file] [seed]");
+            handler->SendSysMessage("Records or verifies the XP of every item of a seed SQL file over a grid of levels, skills and zone multipliers.");
+            return true;
+        }
+
+        std::string path, seedPath;
+        if (!ResolveDataFile(handler, fileStr ? fileStr : "golden.txt", "golden " + action, path) ||
+            !ResolveDataFile(handler, seedStr ? seedStr : "gathering_experience.sql", "golden " + action, seedPath))
+            return false;
+
+        // Scores the seed file, not the live data, and runs over several world updates
+        sGatheringTasks->Start(handler, std::make_unique<GatheringGolden::Task>(action == "write", path, seedPath));
+        return true;
+    }
+
+    static bool HandleGatheringReplayCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringReplayCommand");
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        std::string path;
+        if (!ResolveDataFile(handler, args, "replay", path))
+            return false;
+
+        sGatheringTasks->Start(handler, std::make_unique<GatheringReplayTask>(path, GatheringExperienceModule::instance->GetSnapshot()));
+        return true;
+    }
+
+    static bool HandleGatheringProfileCommand(ChatHandler* handler, const char* args)
+    {
+        if (!GatheringProfiler::IsEnabled())
+        {
+            handler->SendSysMessage("Profiling is not compiled in. Rebuild with GATHERING_EXPERIENCE_PROFILING defined.");
+            return true;
+        }
+
+        char* actionStr = args ? strtok((char*)args, " ") : nullptr;
+        char* fileStr = strtok(nullptr, "\0");
+        std::string action = actionStr ? actionStr : "";
+
+        if (action == "clear")
+        {
+            GatheringProfiler::Clear();
+            handler->SendSysMessage("Profiling buffers cleared.");
+            return true;
+        }
+
+        if (action != "dump")
+        {
+            handler->SendSysMessage("Usage: .gathering profile <dump|clear> [file]");
+            return true;
+        }
+
+        std::string path;
+        if (!ResolveDataFile(handler, fileStr ? fileStr : "trace.json", "profile dump", path))
+            return false;
+
+        uint32 events = 0;
+        if (!GatheringProfiler::DumpChromeTrace(path, events))
+        {
+            handler->PSendSysMessage("Could not write {}.", path);
+            return false;
+        }
+
+        handler->PSendSysMessage("Wrote {} profiling events to {}.", events, path);
+        return true;
+    }
+
+    static std::string FormatDuration(time_t seconds)
+    {
+        if (seconds >= DAY)
+            return Acore::StringFormat("{}d {}h", seconds / DAY, seconds % DAY / HOUR);
+        if (seconds >= HOUR)
+            return Acore::StringFormat("{}h {}m", seconds / HOUR, seconds % HOUR / MINUTE);
+        return Acore::StringFormat("{}m", seconds / MINUTE);
+    }
+
+    static bool HandleGatheringEventsCommand(ChatHandler* handler, const char* /*args*/)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringEventsCommand");
+
+        static char const* const professionNames[GATHERING_PROFESSION_COUNT] = { "Mining", "Herbalism", "Skinning", "Fishing" };
+
+        std::vector<GatheringEvent> const& events = sGatheringEvents->GetEvents();
+        auto state = sGatheringEvents->GetState();
+
+        // Events that ended since the load stay in the list until the next one
+        time_t now = GameTime::GetGameTime().count();
+        if (std::none_of(events.begin(), events.end(), [now](GatheringEvent const& event) { return event.end > now; }))
+        {
+            handler->SendSysMessage("No active or upcoming gathering XP events.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Gathering XP events (epoch {}):", state->epoch);
+        for (GatheringEvent const& event : events)
+        {
+            if (event.end <= now)
+                continue;
+
+            bool active = event.start <= now;
+            std::string scope = event.profession ? professionNames[event.profession - 1] : "All professions";
+            if (event.zoneId)
+                scope += Acore::StringFormat(" in zone {}", event.zoneId);
+
+            handler->PSendSysMessage("[{}] {} - x{} {} - {}", event.id, event.name, event.multiplier, scope,
+                active ? "active, ends in " + FormatDuration(event.end - now)
+                       : "starts in " + FormatDuration(std::max<time_t>(event.start - now, 0)));
+        }
+        return true;
+    }
+
+    static bool HandleGatheringCohortsCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringCohortsCommand");
+
+        static char const* const professionNames[GATHERING_PROFESSION_COUNT] = { "Mining", "Herbalism", "Skinning", "Fishing" };
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        if (args && std::string(args) == "reset")
+        {
+            sGatheringMetrics->ClearCohorts();
+            handler->SendSysMessage("Cohort counters cleared.");
+            return true;
+        }
+
+        auto data = GatheringExperienceModule::instance->GetSnapshot();
+        if (data->cohortMultipliers.empty())
+        {
+            handler->SendSysMessage("No XP experiment is running, gathering_experience_cohorts is empty.");
+            return true;
+        }
+
+        uint32 seed = sGatheringScorer->GetCohortSeed();
+        handler->PSendSysMessage("XP experiment cohorts (seed {}):", seed);
+        for (uint8 cohort = 0; cohort < data->cohortMultipliers.size(); ++cohort)
+        {
+            auto const& multipliers = data->cohortMultipliers[cohort];
+            handler->PSendSysMessage("Cohort {}: Mining x{:.2f}, Herbalism x{:.2f}, Skinning x{:.2f}, Fishing x{:.2f}",
+                cohort, multipliers[0], multipliers[1], multipliers[2], multipliers[3]);
+
+            for (uint8 profession = PROF_MINING; profession <= PROF_FISHING; ++profession)
+            {
+                uint64 gathers = sGatheringMetrics->GetCohortGathers(cohort, profession);
+                if (!gathers)
+                    continue;
+
+                uint64 xp = sGatheringMetrics->GetCohortXP(cohort, profession);
+                handler->PSendSysMessage("  {}: {} gathers, {} XP, {:.1f} XP per gather",
+                    professionNames[profession - 1], gathers, xp, double(xp) / gathers);
+            }
+        }
+
+        if (Player* target = handler->getSelectedPlayer())
+            handler->PSendSysMessage("{} is in cohort {}.", target->GetName(), data->GetCohort(target->GetGUID().GetCounter(), seed));
+        return true;
+    }
+
+    static bool HandleGatheringHeatmapCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringHeatmapCommand");
+
+        static char const* const professionNames[GATHERING_PROFESSION_COUNT] = { "Mining", "Herbalism", "Skinning", "Fishing" };
+
+        char* zoneStr = args ? strtok((char*)args, " ") : nullptr;
+        char* countStr = strtok(nullptr, " ");
+
+        uint32 zoneId = zoneStr ? atoi(zoneStr) : 0;
+        if (!zoneId && handler->GetPlayer())
+            zoneId = handler->GetPlayer()->GetZoneId();
+        if (!zoneId)
+        {
+            handler->SendSysMessage("Usage: .gathering heatmap <zoneId> [count]");
+            return false;
+        }
+
+        uint32 count = countStr ? std::clamp<uint32>(atoi(countStr), 1, 100) : 20;
+
+        if (uint64 dropped = sGatheringHeatmap->GetDropped())
+            handler->PSendSysMessage("{} gathers were not counted because the heatmap table is full, raise GatheringExperience.Heatmap.Cells.", dropped);
+
+        auto task = std::make_unique<GatheringQueryTask>(Acore::StringFormat(
+            "SELECT cell_x, cell_y, profession, gathers, xp FROM gathering_experience_heatmap "
+            "WHERE zone_id = {} ORDER BY gathers DESC LIMIT {}", zoneId, count),
+            Acore::StringFormat("Busiest gathering cells in zone {} (zone multiplier x{:.2f}):", zoneId,
+                GatheringExperienceModule::instance ? GatheringExperienceModule::instance->GetZoneMultiplier(zoneId) : 1.0f),
+            Acore::StringFormat("No gathers recorded in zone {}.", zoneId),
+            [](ChatHandler* output, Field* fields)
+            {
+                float cellSize = GatheringHeatmap::CELL_SIZE;
+                int32 cellX = fields[0].Get<int32>();
+                int32 cellY = fields[1].Get<int32>();
+                uint8 profession = fields[2].Get<uint8>();
+                uint32 gathers = fields[3].Get<uint32>();
+                uint64 xp = fields[4].Get<uint64>();
+
+                output->PSendSysMessage("X {:.0f} to {:.0f}, Y {:.0f} to {:.0f}: {} - {} gathers, {} XP",
+                    cellX * cellSize, (cellX + 1) * cellSize, cellY * cellSize, (cellY + 1) * cellSize,
+                    profession >= PROF_MINING && profession <= PROF_FISHING ? professionNames[profession - 1] : "Unknown",
+                    gathers, xp);
+            });
+
+        // Recent gathers are written first and queried once that commit is done
+        if (!sGatheringHeatmap->IsEnabled())
+            handler->SendSysMessage("The heatmap is disabled (GatheringExperience.Heatmap.Enable), showing stored data only.");
+        else if (WorldDatabaseTransaction trans = sGatheringHeatmap->Drain())
+            task->CommitFirst(std::move(trans));
+
+        sGatheringTasks->Start(handler, std::move(task));
+        return true;
+    }
+
+    static bool HandleGatheringRateCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringRateCommand");
+
+        Player* target = handler->getSelectedPlayer();
+        if (!target)
+            target = handler->GetPlayer();
+
+        GatheringPlayerData* data = target ? GatheringPlayerData::Get(target) : nullptr;
+        if (!data)
+        {
+            handler->SendSysMessage("Select an online player first.");
+            return true;
+        }
+
+        char* scopeStr = args ? strtok((char*)args, " ") : nullptr;
+        char* rateStr = strtok(nullptr, " ");
+        std::string scope = scopeStr ? scopeStr : "";
+
+        if (scope.empty())
+        {
+            handler->PSendSysMessage("Gathering XP rate of {}: account x{}, character x{}, effective x{}",
+                target->GetName(), data->accountRate, data->characterRate, sGatheringRates->GetRate(target));
+            return true;
+        }
+
+        if ((scope != "account" && scope != "character") || !rateStr)
+        {
+            handler->SendSysMessage("Usage: .gathering rate [account|character] [multiplier|reset]");
+            return true;
+        }
+
+        float rate = std::string(rateStr) == "reset" ? 1.0f : atof(rateStr);
+        if (rate < 0.0f || rate > 10.0f)
+        {
+            handler->SendSysMessage("Multiplier must be between 0 and 10.");
+            return true;
+        }
+
+        if (scope == "account")
+            sGatheringRates->SetAccountRate(target, rate);
+        else
+            sGatheringRates->SetCharacterRate(target, rate);
+
+        handler->PSendSysMessage("Set {} gathering XP rate of {} to x{} (effective x{}).",
+            scope, target->GetName(), rate, sGatheringRates->GetRate(target));
+        return true;
+    }
+
+    static bool HandleGatheringStressCommand(ChatHandler* handler, const char* args)
+    {
+        GE_PROFILE_SCOPE("HandleGatheringStressCommand");
+
+        if (!GatheringExperienceModule::instance)
+        {
+            handler->PSendSysMessage("Module instance not found.");
+            return false;
+        }
+
+        // Mock players feed the real stats, heatmap and metrics
+        if (!sGatheringStress->IsAllowed())
+        {
+            handler->SendSysMessage("Stress tests are disabled. Set GatheringExperience.Stress.Enable = 1 on a staging server to allow them.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        char* threadsStr = args ? strtok((char*)args, " ") : nullptr;
+        std::string action = threadsStr ? threadsStr : "";
+
+        // Without arguments, report the last or running test
+        if (action.empty() || action == "status")
+        {
+            std::vector<GatheringStressPhase> phases = sGatheringStress->GetResults();
+            if (phases.empty() && !sGatheringStress->IsRunning())
+            {
+                handler->SendSysMessage("Usage: .gathering stress [threads] [events] [players] [gatherms] [editms]");
+                handler->SendSysMessage("Runs paced mock players through the loot path from 1 up to <threads> threads and reports events/s and latency.");
+                return true;
+            }
+
+            handler->PSendSysMessage("Stress test {}:", sGatheringStress->IsRunning() ? "running" : "finished");
+            for (GatheringStressPhase const& phase : phases)
+            {
+                handler->PSendSysMessage("{} threads: {} events/s (paced at {}), p50 {} ns, p99 {} ns, p99.9 {} ns, max {} ns, {} edits",
+                    phase.threads, static_cast<uint64>(phase.eventsPerSecond), static_cast<uint64>(phase.targetPerSecond),
+                    phase.p50, phase.p99, phase.p999, phase.max, phase.edits);
+            }
+            return true;
+        }
+
+        char* eventsStr = strtok(nullptr, " ");
+        char* playersStr = strtok(nullptr, " ");
+        char* gatherStr = strtok(nullptr, " ");
+        char* editStr = strtok(nullptr, " ");
+
+        GatheringStressSettings settings;
+        settings.maxThreads = std::clamp<uint32>(atoi(threadsStr), 1, 64);
+        settings.eventsPerThread = std::clamp<uint32>(eventsStr ? atoi(eventsStr) : 20000, 1, 1000000);
+        settings.playersPerThread = std::clamp<uint32>(playersStr ? atoi(playersStr) : 2000, 1, 100000);
+        settings.gatherInterval = gatherStr ? atoi(gatherStr) : 3000;
+        settings.editInterval = editStr ? atoi(editStr) : 1000;
+
+        if (!sGatheringStress->Start(settings))
+        {
+            handler->SendSysMessage("A stress test is already running.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Started stress test with up to {} threads, {} events per thread. Use .gathering stress status for results.",
+            settings.maxThreads, settings.eventsPerThread);
         return true;
     }
 
     static bool HandleGatheringZoneAddCommand(ChatHandler* handler, char const* args)
     {
+        GE_PROFILE_SCOPE("HandleGatheringZoneAddCommand");
+
         if (!*args)
         {
             handler->SendSysMessage("Usage: .gathering zone add #zoneId #multiplier #name");
@@ -743,6 +1428,9 @@ public:
 
         WorldDatabase.DirectExecute("REPLACE INTO gathering_experience_zones (zone_id, multiplier, name) VALUES ({}, {}, '{}')",
             zoneId, multiplier, zoneName);
+        sGatheringSync->LogChange(GATHERING_CHANGE_ZONE, zoneId);
+        if (GatheringExperienceModule::instance)
+            GatheringExperienceModule::instance->ApplyChanges({}, { zoneId }, false);
 
         handler->PSendSysMessage("Added multiplier {:.2f}x for zone: {} (ID: {})", 
             multiplier, zoneName, zoneId);
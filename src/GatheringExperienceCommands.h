@@ -24,6 +24,18 @@ private:
     static bool HandleGatheringCurrentZoneCommand(ChatHandler* handler, const char* args);
     static bool HandleGatheringToggleProfessionCommand(ChatHandler* handler, const char* args);
     static bool HandleGatheringStatusCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringImportCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringExportCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringMyStatsCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringTopCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringGoldenCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringProfileCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringStressCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringEventsCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringRateCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringReplayCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringCohortsCommand(ChatHandler* handler, const char* args);
+    static bool HandleGatheringHeatmapCommand(ChatHandler* handler, const char* args);
 };
 
 #endif // GATHERING_EXPERIENCE_COMMANDS_H 
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringGolden.h"
+#include "engine/GatheringSeed.h"
+#include "Timer.h"
+#include <filesystem>
+
+bool GatheringGolden::Task::Step(ChatHandler* handler)
+{
+    if (!opened)
+    {
+        opened = true;
+
+        std::string error;
+        if (!Open(error))
+        {
+            handler->PSendSysMessage("Golden {} failed: {}", write ? "write" : "check", error);
+            return true;
+        }
+    }
+
+    uint32 start = getMSTime();
+    do
+    {
+        if (next == seed.items.end())
+            return Finish(handler);
+
+        auto [itemId, item] = *next;
+        Score(itemId, item);
+        ++next;
+    } while (getMSTimeDiff(start, getMSTime()) < STEP_BUDGET);
+
+    return false;
+}
+
+bool GatheringGolden::Task::Open(std::string& error)
+{
+    if (!GatheringSeed::ParseFile(seedPath, seed, error))
+        return false;
+    next = seed.items.begin();
+
+    if (write)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            error = "could not open " + path + " for writing";
+            return false;
+        }
+
+        zoneMultipliers = GetZoneMultipliers(seed);
+        out << FormatHeader(zoneMultipliers);
+        return true;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    if (!checker.Load(in, error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+void GatheringGolden::Task::Score(uint32 itemId, GatheringItem const& item)
+{
+    if (!write)
+    {
+        checker.Check(itemId, item);
+        return;
+    }
+
+    rows.clear();
+    Evaluate(itemId, item, zoneMultipliers, rows);
+    for (Row const& row : rows)
+        out << FormatRow(row);
+    ++items;
+}
+
+bool GatheringGolden::Task::Finish(ChatHandler* handler)
+{
+    if (write)
+    {
+        out.close();
+        handler->PSendSysMessage("Recorded golden XP for {} items of {} to {}.", items, seedPath, path);
+        return true;
+    }
+
+    Report const& report = checker.Finish();
+    for (Difference const& difference : report.differences)
+    {
+        GatheringItem const* item = seed.items.Find(difference.itemId);
+        handler->PSendSysMessage("Item {} ({}) level {} skill {} zone {}: expected {}, got {}",
+            difference.itemId, item ? seed.items.GetName(*item) : "", difference.level, difference.skill,
+            FormatZone(difference.zoneMultiplier),
+            difference.expected ? std::to_string(*difference.expected) : "no row",
+            difference.actual ? std::to_string(*difference.actual) : "no row");
+    }
+    if (report.differing > report.differences.size())
+        handler->PSendSysMessage("... and {} more differences", report.differing - report.differences.size());
+
+    for (uint32 itemId : report.added)
+        handler->PSendSysMessage("Item {} is not in the golden table", itemId);
+    for (uint32 itemId : report.removed)
+        handler->PSendSysMessage("Item {} is in the golden table but not in the seed", itemId);
+
+    handler->PSendSysMessage("Golden check {}: {} items checked, {} changed, {} added, {} removed.",
+        report.Passed() ? "passed" : "FAILED", report.checked, report.changed.size(), report.added.size(), report.removed.size());
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_GOLDEN_H
+#define MODULE_GATHERING_EXPERIENCE_GOLDEN_H
+
+#include "GatheringExperience.h"
+#include "engine/GatheringGoldenTable.h"
+#include "GatheringTasks.h"
+#include <fstream>
+
+// Golden XP tables from the server: the items of a seed SQL file (the
+// module's gathering_experience.sql by default) are scored through the
+// engine and written as, or checked against, a readable golden table. The
+// live data is never used, so GM edits don't show up as regressions; the
+// standalone tests in tests/ check the same table format.
+namespace GatheringGolden
+{
+    // Writes or checks a golden table, scoring items until the step budget
+    // is spent so large seed files spread over several world updates
+    class Task : public GatheringTask
+    {
+    public:
+        static const uint32 STEP_BUDGET = 5; // Milliseconds
+
+        Task(bool write, std::string path, std::string seedPath)
+            : write(write), path(std::move(path)), seedPath(std::move(seedPath)), next(seed.items.begin()) { }
+
+        bool Step(ChatHandler* handler) override;
+
+        // A table that is being written is never left half done
+        bool IsDroppable() const override { return !write; }
+
+    private:
+        bool Open(std::string& error);
+        void Score(uint32 itemId, GatheringItem const& item);
+        bool Finish(ChatHandler* handler);
+
+        bool write;
+        std::string path;
+        std::string seedPath;
+        GatheringSnapshot seed;
+        GatheringItemTable::const_iterator next;
+        bool opened{false};
+
+        std::vector<float> zoneMultipliers;
+        std::vector<Row> rows;
+        std::ofstream out;
+        Checker checker;
+        uint32 items{0};
+    };
+}
+
+#endif //MODULE_GATHERING_EXPERIENCE_GOLDEN_H
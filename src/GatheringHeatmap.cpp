@@ -0,0 +1,140 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringHeatmap.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include <bit>
+#include <cmath>
+
+namespace
+{
+    // zone (16 bits), cell x and y (16 bits each, signed), profession (8 bits)
+    // and a set top bit so no key is 0, which marks an empty cell
+    uint64 MakeKey(uint32 zoneId, int32 cellX, int32 cellY, uint8 profession)
+    {
+        return (uint64(1) << 63) | (uint64(zoneId & 0xFFFF) << 40) | (uint64(uint16(cellX)) << 24) | (uint64(uint16(cellY)) << 8) | profession;
+    }
+
+    uint32 KeyZone(uint64 key)       { return uint32(key >> 40) & 0xFFFF; }
+    int32 KeyCellX(uint64 key)       { return int16(key >> 24); }
+    int32 KeyCellY(uint64 key)       { return int16(key >> 8); }
+    uint8 KeyProfession(uint64 key)  { return uint8(key); }
+}
+
+GatheringHeatmap* GatheringHeatmap::instance()
+{
+    static GatheringHeatmap instance;
+    return &instance;
+}
+
+void GatheringHeatmap::LoadConfig()
+{
+    enabled = sConfigMgr->GetOption<bool>("GatheringExperience.Heatmap.Enable", false);
+    interval = sConfigMgr->GetOption<uint32>("GatheringExperience.Heatmap.Interval", 300) * 1000;
+
+    // Config loads run on the world thread while no map is updating
+    uint32 size = std::bit_ceil(std::max<uint32>(sConfigMgr->GetOption<uint32>("GatheringExperience.Heatmap.Cells", 65536), 1024));
+    if (enabled && size != capacity)
+    {
+        Flush();
+        cells.store(nullptr, std::memory_order_relaxed);
+        for (std::unique_ptr<Cell[]>& table : tables)
+            table = std::make_unique<Cell[]>(size);
+        capacity = size;
+        cells.store(tables[0].get(), std::memory_order_release);
+    }
+}
+
+void GatheringHeatmap::Record(uint32 zoneId, float x, float y, uint8 profession, uint32 xp)
+{
+    Cell* table = cells.load(std::memory_order_acquire);
+    if (!enabled || !table)
+        return;
+
+    uint64 key = MakeKey(zoneId, int32(std::floor(x / CELL_SIZE)), int32(std::floor(y / CELL_SIZE)), profession);
+    uint32 slot = uint32((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+
+    for (uint32 probe = 0; probe < MAX_PROBES; ++probe, slot = (slot + 1) & (capacity - 1))
+    {
+        Cell& cell = table[slot];
+        uint64 current = cell.key.load(std::memory_order_relaxed);
+        if (current == 0 && cell.key.compare_exchange_strong(current, key, std::memory_order_relaxed))
+            current = key;
+
+        if (current == key)
+        {
+            cell.gathers.fetch_add(1, std::memory_order_relaxed);
+            cell.xp.fetch_add(xp, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GatheringHeatmap::Update(uint32 diff)
+{
+    if (!enabled)
+        return;
+
+    timer += diff;
+    if (timer < interval)
+        return;
+
+    timer = 0;
+    Flush();
+}
+
+void GatheringHeatmap::Flush()
+{
+    if (WorldDatabaseTransaction trans = Drain())
+        WorldDatabase.CommitTransaction(trans);
+}
+
+WorldDatabaseTransaction GatheringHeatmap::Drain()
+{
+    Cell* table = cells.load(std::memory_order_relaxed);
+    if (!table)
+        return nullptr;
+
+    // Flushes run on the world thread while no map is updating, so once
+    // gathers go to the other table nothing writes to this one
+    cells.store(table == tables[0].get() ? tables[1].get() : tables[0].get(), std::memory_order_release);
+
+    WorldDatabaseTransaction trans = WorldDatabase.BeginTransaction();
+    std::string values;
+    uint32 rows = 0;
+    for (uint32 i = 0; i < capacity; ++i)
+    {
+        Cell& cell = table[i];
+        uint64 key = cell.key.load(std::memory_order_relaxed);
+        if (!key)
+            continue;
+
+        uint32 gathers = cell.gathers.exchange(0, std::memory_order_relaxed);
+        uint64 xp = cell.xp.exchange(0, std::memory_order_relaxed);
+        cell.key.store(0, std::memory_order_relaxed);
+        if (!gathers)
+            continue;
+
+        if (!values.empty())
+            values += ", ";
+        values += Acore::StringFormat("({}, {}, {}, {}, {}, {})",
+            KeyZone(key), KeyCellX(key), KeyCellY(key), KeyProfession(key), gathers, xp);
+
+        if (++rows % ROWS_PER_STATEMENT == 0)
+        {
+            trans->Append("INSERT INTO gathering_experience_heatmap (zone_id, cell_x, cell_y, profession, gathers, xp) VALUES " + values +
+                " ON DUPLICATE KEY UPDATE gathers = gathers + VALUES(gathers), xp = xp + VALUES(xp)");
+            values.clear();
+        }
+    }
+
+    if (!values.empty())
+        trans->Append("INSERT INTO gathering_experience_heatmap (zone_id, cell_x, cell_y, profession, gathers, xp) VALUES " + values +
+            " ON DUPLICATE KEY UPDATE gathers = gathers + VALUES(gathers), xp = xp + VALUES(xp)");
+
+    return rows ? trans : nullptr;
+}
@@ -0,0 +1,63 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_HEATMAP_H
+#define MODULE_GATHERING_EXPERIENCE_HEATMAP_H
+
+#include "GatheringExperience.h"
+#include <array>
+#include <atomic>
+#include <memory>
+
+// Where players gather: counts and XP per (zone, grid cell, profession),
+// summed in a fixed size open addressing table and periodically added to
+// gathering_experience_heatmap in one transaction of batched inserts.
+// Recording is a hash, a short probe and two relaxed atomic adds. There are
+// two tables: a flush switches gathers to the other one and empties the
+// old one entirely, so cells no longer gathered in free up.
+class GatheringHeatmap
+{
+public:
+    static constexpr float CELL_SIZE = 100.0f; // Yards per cell side
+
+    static GatheringHeatmap* instance();
+
+    void LoadConfig();
+
+    bool IsEnabled() const { return enabled; }
+
+    void Record(uint32 zoneId, float x, float y, uint8 profession, uint32 xp);
+
+    // World thread only
+    void Update(uint32 diff);
+
+    // Writes and clears the counts gathered since the last flush
+    void Flush();
+
+    // Clears the counts gathered since the last flush and returns them as a
+    // transaction of inserts for the caller to commit, null if there are none
+    WorldDatabaseTransaction Drain();
+
+    // Gathers that found the table full since startup
+    uint64 GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<uint64> key{0};
+        std::atomic<uint32> gathers{0};
+        std::atomic<uint64> xp{0};
+    };
+
+    static constexpr uint32 MAX_PROBES = 16;
+    static constexpr uint32 ROWS_PER_STATEMENT = 500;
+
+    bool enabled{false};
+    uint32 interval{300000};
+    uint32 timer{0};
+    uint32 capacity{0};  // Power of two
+    std::array<std::unique_ptr<Cell[]>, 2> tables;
+    std::atomic<Cell*> cells{nullptr}; // The table gathers are recorded into
+    std::atomic<uint64> dropped{0};
+};
+
+#define sGatheringHeatmap GatheringHeatmap::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_HEATMAP_H
@@ -0,0 +1,256 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringImport.h"
+#include "GatheringSync.h"
+#include "StringConvert.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Splits one CSV line, honouring double quoted fields with "" escapes
+    std::vector<std::string> SplitCsvLine(std::string const& line)
+    {
+        std::vector<std::string> fields;
+        std::string field;
+        bool quoted = false;
+
+        for (std::size_t i = 0; i < line.size(); ++i)
+        {
+            char c = line[i];
+            if (quoted)
+            {
+                if (c != '"')
+                    field += c;
+                else if (i + 1 < line.size() && line[i + 1] == '"')
+                    field += line[++i];
+                else
+                    quoted = false;
+            }
+            else if (c == '"')
+                quoted = true;
+            else if (c == ',')
+            {
+                fields.push_back(field);
+                field.clear();
+            }
+            else if (c != '\r')
+                field += c;
+        }
+
+        fields.push_back(field);
+        return fields;
+    }
+
+    // Reads a whole number within the column's range, false after telling the
+    // handler which field of the line is bad
+    bool ParseNumber(ChatHandler* handler, uint32 lineNumber, std::string const& text, char const* field,
+        uint32 min, uint32 max, uint32& value)
+    {
+        Optional<uint32> parsed = Acore::StringTo<uint32>(text);
+        if (!parsed || *parsed < min || *parsed > max)
+        {
+            handler->PSendSysMessage("Line {}: {} must be a whole number from {} to {}, not \"{}\".", lineNumber, field, min, max, text);
+            return false;
+        }
+
+        value = *parsed;
+        return true;
+    }
+
+    bool ParseMultiplier(ChatHandler* handler, uint32 lineNumber, std::string const& text, float& value)
+    {
+        Optional<float> parsed = Acore::StringTo<float>(text);
+        if (!parsed || !std::isfinite(*parsed) || *parsed <= 0.0f)
+        {
+            handler->PSendSysMessage("Line {}: multiplier must be a number greater than 0, not \"{}\".", lineNumber, text);
+            return false;
+        }
+
+        value = *parsed;
+        return true;
+    }
+
+    // Appends the rows as a few multi-row INSERT statements instead of one per row
+    void AppendBulkInsert(WorldDatabaseTransaction& trans, std::string const& insert,
+        std::vector<std::string> const& rows, std::string const& onDuplicate)
+    {
+        static constexpr std::size_t ROWS_PER_STATEMENT = 500;
+
+        for (std::size_t first = 0; first < rows.size(); first += ROWS_PER_STATEMENT)
+        {
+            std::size_t last = std::min(rows.size(), first + ROWS_PER_STATEMENT);
+            std::string query = insert;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                if (i != first)
+                    query += ", ";
+                query += rows[i];
+            }
+            query += onDuplicate;
+            trans->Append(query);
+        }
+    }
+}
+
+bool GatheringImportTask::Step(ChatHandler* handler)
+{
+    if (!opened)
+    {
+        opened = true;
+        in.open(path);
+        if (!in)
+        {
+            handler->PSendSysMessage("Could not open {}.", path);
+            return true;
+        }
+    }
+
+    if (!committing)
+    {
+        std::string line;
+        for (uint32 lines = 0; lines < LINES_PER_STEP; ++lines)
+        {
+            if (!std::getline(in, line))
+            {
+                Commit(handler);
+                return committed && Finish(handler);
+            }
+
+            ++lineNumber;
+            if (line.empty() || line[0] == '#' || line == "\r")
+                continue;
+
+            if (!ParseLine(handler, line))
+                return true;
+        }
+        return false;
+    }
+
+    if (!committed)
+    {
+        commitProcessor.ProcessReadyCallbacks();
+        if (!committed)
+            return false;
+    }
+
+    return Finish(handler);
+}
+
+bool GatheringImportTask::ParseLine(ChatHandler* handler, std::string const& line)
+{
+    std::vector<std::string> fields = SplitCsvLine(line);
+    std::string const& type = fields[0];
+
+    if (type == "item" && fields.size() == 7)
+    {
+        // item,item_id,base_xp,required_skill,profession,recommended_level,name
+        uint32 itemId, baseXP, requiredSkill, profession, level;
+        if (!ParseNumber(handler, lineNumber, fields[1], "item_id", 1, std::numeric_limits<uint32>::max(), itemId) ||
+            !ParseNumber(handler, lineNumber, fields[2], "base_xp", 0, std::numeric_limits<uint32>::max(), baseXP) ||
+            !ParseNumber(handler, lineNumber, fields[3], "required_skill", 0, std::numeric_limits<uint32>::max(), requiredSkill) ||
+            !ParseNumber(handler, lineNumber, fields[4], "profession", 1, 4, profession))
+            return false;
+
+        // Empty derives the level from base_xp at load
+        std::string recommendedLevel = "NULL";
+        if (!fields[5].empty())
+        {
+            if (!ParseNumber(handler, lineNumber, fields[5], "recommended_level", 1, GATHERING_MAX_LEVEL, level))
+                return false;
+            recommendedLevel = std::to_string(level);
+        }
+
+        std::string name = fields[6];
+        WorldDatabase.EscapeString(name);
+
+        itemRows.push_back(Acore::StringFormat("({}, {}, {}, {}, {}, '{}')",
+            itemId, baseXP, requiredSkill, profession, recommendedLevel, name));
+        return true;
+    }
+
+    if (type == "zone" && fields.size() == 4)
+    {
+        // zone,zone_id,multiplier,name
+        uint32 zoneId;
+        float multiplier;
+        if (!ParseNumber(handler, lineNumber, fields[1], "zone_id", 0, std::numeric_limits<uint32>::max(), zoneId) ||
+            !ParseMultiplier(handler, lineNumber, fields[2], multiplier))
+            return false;
+
+        std::string name = fields[3];
+        WorldDatabase.EscapeString(name);
+        zoneRows.push_back(Acore::StringFormat("({}, {}, '{}')", zoneId, multiplier, name));
+        return true;
+    }
+
+    if (type == "rarity" && fields.size() == 3)
+    {
+        // rarity,item_id,multiplier
+        uint32 itemId;
+        float multiplier;
+        if (!ParseNumber(handler, lineNumber, fields[1], "item_id", 1, std::numeric_limits<uint32>::max(), itemId) ||
+            !ParseMultiplier(handler, lineNumber, fields[2], multiplier))
+            return false;
+
+        rarityRows.push_back(Acore::StringFormat("({}, {})", itemId, multiplier));
+        return true;
+    }
+
+    handler->PSendSysMessage("Line {}: unrecognised record, nothing was imported.", lineNumber);
+    return false;
+}
+
+void GatheringImportTask::Commit(ChatHandler* handler)
+{
+    committing = true;
+
+    // Items go first, rarity rows reference them
+    WorldDatabaseTransaction trans = WorldDatabase.BeginTransaction();
+    AppendBulkInsert(trans,
+        "INSERT INTO gathering_experience (item_id, base_xp, required_skill, profession, recommended_level, name) VALUES ",
+        itemRows,
+        " ON DUPLICATE KEY UPDATE base_xp = VALUES(base_xp), required_skill = VALUES(required_skill), "
+        "profession = VALUES(profession), recommended_level = VALUES(recommended_level), name = VALUES(name)");
+    AppendBulkInsert(trans,
+        "INSERT INTO gathering_experience_zones (zone_id, multiplier, name) VALUES ",
+        zoneRows,
+        " ON DUPLICATE KEY UPDATE multiplier = VALUES(multiplier), name = VALUES(name)");
+    AppendBulkInsert(trans,
+        "INSERT INTO gathering_experience_rarity (item_id, multiplier) VALUES ",
+        rarityRows,
+        " ON DUPLICATE KEY UPDATE multiplier = VALUES(multiplier)");
+
+    // The console waits for the commit, there is no later update to pick it up
+    if (!handler->GetSession())
+    {
+        WorldDatabase.DirectCommitTransaction(trans);
+        committed = succeeded = true;
+        return;
+    }
+
+    commitProcessor.AddCallback(WorldDatabase.AsyncCommitTransaction(trans)).AfterComplete([this](bool success)
+    {
+        succeeded = success;
+        committed = true;
+    });
+}
+
+bool GatheringImportTask::Finish(ChatHandler* handler)
+{
+    if (!succeeded)
+    {
+        handler->PSendSysMessage("Importing {} failed, nothing was imported.", path);
+        return true;
+    }
+
+    // The other servers reload on the logged change, this one right away
+    sGatheringSync->LogChange(GATHERING_CHANGE_RELOAD);
+    GatheringExperienceModule::instance->LoadDataFromDB();
+
+    handler->PSendSysMessage("Imported {} items, {} zones and {} rarity multipliers from {}.",
+        itemRows.size(), zoneRows.size(), rarityRows.size(), path);
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_IMPORT_H
+#define MODULE_GATHERING_EXPERIENCE_IMPORT_H
+
+#include "GatheringExperience.h"
+#include "GatheringTasks.h"
+#include <fstream>
+
+// Imports a CSV file written by .gathering export. The file is parsed a
+// chunk of lines per step, written in one transaction that commits
+// asynchronously, and the data is reloaded in a last step once the commit
+// is done. A bad line stops the import before anything is written.
+class GatheringImportTask : public GatheringTask
+{
+public:
+    static const uint32 LINES_PER_STEP = 1000;
+
+    explicit GatheringImportTask(std::string path) : path(std::move(path)) { }
+
+    bool Step(ChatHandler* handler) override;
+
+    // The reload and change log have to follow a commit
+    bool IsDroppable() const override { return false; }
+
+private:
+    // False after telling the handler what is wrong with the line
+    bool ParseLine(ChatHandler* handler, std::string const& line);
+    void Commit(ChatHandler* handler);
+    bool Finish(ChatHandler* handler);
+
+    std::string path;
+    std::ifstream in;
+    bool opened{false};
+    uint32 lineNumber{0};
+
+    std::vector<std::string> itemRows;
+    std::vector<std::string> zoneRows;
+    std::vector<std::string> rarityRows;
+
+    AsyncCallbackProcessor<TransactionCallback> commitProcessor;
+    bool committing{false};
+    bool committed{false};
+    bool succeeded{false};
+};
+
+#endif //MODULE_GATHERING_EXPERIENCE_IMPORT_H
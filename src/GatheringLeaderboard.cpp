@@ -0,0 +1,191 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringLeaderboard.h"
+#include "CharacterCache.h"
+#include "DatabaseEnv.h"
+
+GatheringLeaderboard* GatheringLeaderboard::instance()
+{
+    static GatheringLeaderboard instance;
+    return &instance;
+}
+
+void GatheringLeaderboard::SetSize(uint32 newSize)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    size = std::max(1u, newSize);
+    capacity = size * 2;
+
+    for (Board& board : boards)
+    {
+        if (board.entries.size() > capacity)
+            board.entries.resize(capacity);
+        board.entries.reserve(capacity); // Gathers entering the board never allocate
+        board.threshold.store(board.entries.size() == capacity ? board.entries.back().gathers : 0, std::memory_order_relaxed);
+    }
+}
+
+void GatheringLeaderboard::LoadFromDB()
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    for (Board& board : boards)
+    {
+        board.entries.clear();
+        board.threshold.store(0, std::memory_order_relaxed);
+    }
+
+    // One pass over the stats table, each row goes through the same bounded insert as live updates
+    QueryResult result = CharacterDatabase.Query(
+        "SELECT s.guid, s.profession, s.gathers, s.xp_earned "
+        "FROM character_gathering_stats s JOIN characters c ON c.guid = s.guid");
+    if (!result)
+        return;
+
+    uint32 count = 0;
+    do
+    {
+        Field* fields = result->Fetch();
+        uint8 profession = fields[1].Get<uint8>();
+        if (profession < PROF_MINING || profession > PROF_FISHING)
+            continue;
+
+        UpdateLocked(boards[profession - 1], fields[0].Get<uint32>(), fields[2].Get<uint32>(), fields[3].Get<uint64>());
+        ++count;
+    } while (result->NextRow());
+
+    LOG_INFO("module", "Built gathering leaderboards from {} statistic rows", count);
+}
+
+void GatheringLeaderboard::Update(ObjectGuid::LowType guid, uint8 profession, uint32 gathers, uint64 xpEarned)
+{
+    if (profession < PROF_MINING || profession > PROF_FISHING)
+        return;
+
+    Board& board = boards[profession - 1];
+
+    // Most gathers cannot reach a full board, skip the lock for them
+    if (gathers <= board.threshold.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    UpdateLocked(board, guid, gathers, xpEarned);
+}
+
+void GatheringLeaderboard::UpdateLocked(Board& board, ObjectGuid::LowType guid, uint32 gathers, uint64 xpEarned)
+{
+    auto& entries = board.entries;
+
+    auto it = std::find_if(entries.begin(), entries.end(),
+        [guid](GatheringLeaderboardEntry const& entry) { return entry.guid == guid; });
+
+    if (it == entries.end())
+    {
+        if (entries.size() < capacity)
+        {
+            entries.push_back({ guid, gathers, xpEarned, {} });
+        }
+        else
+        {
+            if (gathers <= entries.back().gathers)
+                return;
+            entries.back() = { guid, gathers, xpEarned, {} };
+        }
+        it = entries.end() - 1;
+    }
+    else
+    {
+        it->gathers = gathers;
+        it->xpEarned = xpEarned;
+    }
+
+    // Only this entry moved up, bubble it into place
+    while (it != entries.begin() && (it - 1)->gathers < it->gathers)
+    {
+        std::iter_swap(it, it - 1);
+        --it;
+    }
+
+    board.threshold.store(entries.size() == capacity ? entries.back().gathers : 0, std::memory_order_relaxed);
+}
+
+void GatheringLeaderboard::Remove(ObjectGuid::LowType guid)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (pendingRefills)
+        removedDuringRefill.push_back(guid);
+
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+    {
+        auto& entries = boards[i].entries;
+        bool full = entries.size() == capacity;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+            [guid](GatheringLeaderboardEntry const& entry) { return entry.guid == guid; }), entries.end());
+        boards[i].threshold.store(entries.size() == capacity ? entries.back().gathers : 0, std::memory_order_relaxed);
+
+        // A board that was not full already holds everyone with stats
+        if (full && entries.size() < capacity)
+            Refill(i + PROF_MINING, guid);
+    }
+}
+
+void GatheringLeaderboard::Refill(uint8 profession, ObjectGuid::LowType removedGuid)
+{
+    // A backward range read of idx_profession_gathers that stops after the limit.
+    // The delete of the stats rows may still be queued, so leave the character out here
+    ++pendingRefills;
+    refillProcessor.AddCallback(CharacterDatabase.AsyncQuery(Acore::StringFormat(
+        "SELECT s.guid, s.gathers, s.xp_earned FROM character_gathering_stats s JOIN characters c ON c.guid = s.guid "
+        "WHERE s.profession = {} AND s.guid <> {} ORDER BY s.gathers DESC LIMIT {}",
+        profession, removedGuid, capacity))
+        .WithCallback([this, profession](QueryResult result)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (result)
+            {
+                Board& board = boards[profession - 1];
+                do
+                {
+                    Field* fields = result->Fetch();
+                    ObjectGuid::LowType guid = fields[0].Get<uint32>();
+
+                    // Entries on the board are live counts, the saved ones may be older
+                    bool present = std::any_of(board.entries.begin(), board.entries.end(),
+                        [guid](GatheringLeaderboardEntry const& entry) { return entry.guid == guid; });
+                    if (!present && std::find(removedDuringRefill.begin(), removedDuringRefill.end(), guid) == removedDuringRefill.end())
+                        UpdateLocked(board, guid, fields[1].Get<uint32>(), fields[2].Get<uint64>());
+                } while (result->NextRow());
+            }
+
+            if (!--pendingRefills)
+                removedDuringRefill.clear();
+        }));
+}
+
+void GatheringLeaderboard::ProcessRefills()
+{
+    refillProcessor.ProcessReadyCallbacks();
+}
+
+std::vector<GatheringLeaderboardEntry> GatheringLeaderboard::GetTop(uint8 profession, uint32 count) const
+{
+    if (profession < PROF_MINING || profession > PROF_FISHING)
+        return {};
+
+    std::vector<GatheringLeaderboardEntry> top;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto const& entries = boards[profession - 1].entries;
+        count = std::min<uint32>({ count, size, static_cast<uint32>(entries.size()) });
+        top.assign(entries.begin(), entries.begin() + count);
+    }
+
+    for (GatheringLeaderboardEntry& entry : top)
+        if (!sCharacterCache->GetCharacterNameByGuid(ObjectGuid::Create<HighGuid::Player>(entry.guid), entry.name))
+            entry.name = "Unknown";
+    return top;
+}
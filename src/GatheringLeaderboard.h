@@ -0,0 +1,61 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_LEADERBOARD_H
+#define MODULE_GATHERING_EXPERIENCE_LEADERBOARD_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include <atomic>
+#include <mutex>
+
+struct GatheringLeaderboardEntry
+{
+    ObjectGuid::LowType guid;
+    uint32 gathers;
+    uint64 xpEarned;
+    std::string name; // Only filled in by GetTop, boards keep no strings
+};
+
+// Bounded top-K of gatherers per profession, ranked by gather count. Totals
+// only ever grow, so feeding every gather in keeps the boards exact without
+// ever sorting the whole stats table. Deleting a character leaves a hole in
+// a full board, which is refilled from the stats table in the background.
+class GatheringLeaderboard
+{
+public:
+    static GatheringLeaderboard* instance();
+
+    void SetSize(uint32 size);
+    uint32 GetSize() const { return size; }
+
+    void LoadFromDB();
+    void Update(ObjectGuid::LowType guid, uint8 profession, uint32 gathers, uint64 xpEarned);
+    void Remove(ObjectGuid::LowType guid);
+
+    // Applies finished refills, world thread only
+    void ProcessRefills();
+
+    // Names come from the character cache
+    std::vector<GatheringLeaderboardEntry> GetTop(uint8 profession, uint32 count) const;
+
+private:
+    struct Board
+    {
+        std::vector<GatheringLeaderboardEntry> entries; // Sorted by gathers, descending
+        std::atomic<uint32> threshold{0};               // Lowest count on a full board
+    };
+
+    void UpdateLocked(Board& board, ObjectGuid::LowType guid, uint32 gathers, uint64 xpEarned);
+    void Refill(uint8 profession, ObjectGuid::LowType removedGuid);
+
+    std::array<Board, GATHERING_PROFESSION_COUNT> boards;
+    mutable std::mutex lock;
+    uint32 size{10};
+    uint32 capacity{20}; // Extra room so deleted characters do not leave holes
+
+    QueryCallbackProcessor refillProcessor;
+    uint32 pendingRefills{0};
+    std::vector<ObjectGuid::LowType> removedDuringRefill; // Kept out of refills already on their way
+};
+
+#define sGatheringLeaderboard GatheringLeaderboard::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_LEADERBOARD_H
@@ -0,0 +1,180 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringMetrics.h"
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    char const* const PROFESSION_LABELS[GATHERING_PROFESSION_COUNT] = { "mining", "herbalism", "skinning", "fishing" };
+    char const* const EDIT_LABELS[] = { "reload", "item", "zone", "setting" };
+
+    void AppendHeader(std::string& text, char const* name, char const* type, char const* help)
+    {
+        text += Acore::StringFormat("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    }
+}
+
+GatheringMetrics* GatheringMetrics::instance()
+{
+    static GatheringMetrics instance;
+    return &instance;
+}
+
+GatheringMetrics::~GatheringMetrics()
+{
+    Stop();
+}
+
+void GatheringMetrics::Configure(std::string const& path, uint32 interval)
+{
+    {
+        std::lock_guard<std::mutex> guard(configLock);
+        filePath = path;
+        writeInterval = std::max(interval, 1u);
+        stopping = false;
+    }
+    wakeup.notify_one();
+
+    if (!path.empty() && !writer.joinable())
+        writer = std::thread(&GatheringMetrics::Run, this);
+}
+
+void GatheringMetrics::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(configLock);
+        stopping = true;
+    }
+    wakeup.notify_one();
+
+    if (writer.joinable())
+        writer.join();
+}
+
+void GatheringMetrics::OnLoot(uint8 profession)
+{
+    lootEvents.fetch_add(1, std::memory_order_relaxed);
+    if (profession >= 1 && profession <= GATHERING_PROFESSION_COUNT)
+        lootHits[profession - 1].fetch_add(1, std::memory_order_relaxed);
+    else
+        lootMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GatheringMetrics::OnExperience(uint8 profession, uint32 xp, uint8 cohort)
+{
+    if (profession < 1 || profession > GATHERING_PROFESSION_COUNT || cohort >= GATHERING_MAX_COHORTS)
+        return;
+
+    xpAwarded[profession - 1].fetch_add(xp, std::memory_order_relaxed);
+    cohortGathers[cohort][profession - 1].fetch_add(1, std::memory_order_relaxed);
+    cohortXP[cohort][profession - 1].fetch_add(xp, std::memory_order_relaxed);
+}
+
+void GatheringMetrics::ClearCohorts()
+{
+    for (uint8 cohort = 0; cohort < GATHERING_MAX_COHORTS; ++cohort)
+    {
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        {
+            cohortGathers[cohort][i].store(0, std::memory_order_relaxed);
+            cohortXP[cohort][i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void GatheringMetrics::OnEdit(uint8 changeType)
+{
+    if (changeType < EDIT_TYPE_COUNT)
+        edits[changeType].fetch_add(1, std::memory_order_relaxed);
+}
+
+void GatheringMetrics::OnReload(uint64 microseconds)
+{
+    for (std::size_t i = 0; i < RELOAD_BUCKETS.size(); ++i)
+        if (microseconds <= RELOAD_BUCKETS[i])
+            reloadBuckets[i].fetch_add(1, std::memory_order_relaxed);
+
+    reloadCount.fetch_add(1, std::memory_order_relaxed);
+    reloadMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+}
+
+void GatheringMetrics::Run()
+{
+    std::unique_lock<std::mutex> lock(configLock);
+    while (!stopping)
+    {
+        wakeup.wait_for(lock, std::chrono::seconds(writeInterval));
+        if (stopping || filePath.empty())
+            continue;
+
+        std::string path = filePath;
+        lock.unlock();
+        if (!Write(path, Render()))
+            LOG_ERROR("module", "Could not write gathering metrics to {}", path);
+        lock.lock();
+    }
+}
+
+std::string GatheringMetrics::Render() const
+{
+    std::string text;
+
+    AppendHeader(text, "gathering_loot_events_total", "counter", "Items looted while the module is enabled.");
+    text += Acore::StringFormat("gathering_loot_events_total {}\n", lootEvents.load(std::memory_order_relaxed));
+
+    AppendHeader(text, "gathering_loot_misses_total", "counter", "Looted items that are not gathering items.");
+    text += Acore::StringFormat("gathering_loot_misses_total {}\n", lootMisses.load(std::memory_order_relaxed));
+
+    AppendHeader(text, "gathering_loot_hits_total", "counter", "Looted gathering items by profession.");
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        text += Acore::StringFormat("gathering_loot_hits_total{{profession=\"{}\"}} {}\n", PROFESSION_LABELS[i], lootHits[i].load(std::memory_order_relaxed));
+
+    AppendHeader(text, "gathering_xp_awarded_total", "counter", "Experience awarded by profession.");
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+        text += Acore::StringFormat("gathering_xp_awarded_total{{profession=\"{}\"}} {}\n", PROFESSION_LABELS[i], xpAwarded[i].load(std::memory_order_relaxed));
+
+    // Only cohorts that saw a gather, most servers run no experiment
+    AppendHeader(text, "gathering_cohort_gathers_total", "counter", "Awarded gathers by XP experiment cohort and profession.");
+    for (uint8 cohort = 0; cohort < GATHERING_MAX_COHORTS; ++cohort)
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+            if (uint64 gathers = cohortGathers[cohort][i].load(std::memory_order_relaxed))
+                text += Acore::StringFormat("gathering_cohort_gathers_total{{cohort=\"{}\",profession=\"{}\"}} {}\n", cohort, PROFESSION_LABELS[i], gathers);
+
+    AppendHeader(text, "gathering_cohort_xp_total", "counter", "Experience awarded by XP experiment cohort and profession.");
+    for (uint8 cohort = 0; cohort < GATHERING_MAX_COHORTS; ++cohort)
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+            if (cohortGathers[cohort][i].load(std::memory_order_relaxed))
+                text += Acore::StringFormat("gathering_cohort_xp_total{{cohort=\"{}\",profession=\"{}\"}} {}\n", cohort, PROFESSION_LABELS[i], cohortXP[cohort][i].load(std::memory_order_relaxed));
+
+    AppendHeader(text, "gathering_gm_edits_total", "counter", "Gathering data changes made by commands.");
+    for (uint8 i = 0; i < EDIT_TYPE_COUNT; ++i)
+        text += Acore::StringFormat("gathering_gm_edits_total{{type=\"{}\"}} {}\n", EDIT_LABELS[i], edits[i].load(std::memory_order_relaxed));
+
+    AppendHeader(text, "gathering_reload_duration_seconds", "histogram", "Time spent loading gathering data.");
+    for (std::size_t i = 0; i < RELOAD_BUCKETS.size(); ++i)
+        text += Acore::StringFormat("gathering_reload_duration_seconds_bucket{{le=\"{}\"}} {}\n", RELOAD_BUCKETS[i] / 1e6, reloadBuckets[i].load(std::memory_order_relaxed));
+
+    uint64 count = reloadCount.load(std::memory_order_relaxed);
+    text += Acore::StringFormat("gathering_reload_duration_seconds_bucket{{le=\"+Inf\"}} {}\n", count);
+    text += Acore::StringFormat("gathering_reload_duration_seconds_sum {}\n", reloadMicroseconds.load(std::memory_order_relaxed) / 1e6);
+    text += Acore::StringFormat("gathering_reload_duration_seconds_count {}\n", count);
+
+    text += "# EOF\n";
+    return text;
+}
+
+bool GatheringMetrics::Write(std::string const& path, std::string const& text) const
+{
+    // Write next to the target and rename, so the collector never reads a partial file
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(text.data(), text.size()))
+            return false;
+    }
+
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,65 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_METRICS_H
+#define MODULE_GATHERING_EXPERIENCE_METRICS_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include "engine/GatheringSnapshot.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Module counters, written periodically in Prometheus/OpenMetrics text
+// format for the node exporter textfile collector. Counting is a relaxed
+// atomic increment; the text is built and written by a separate thread.
+class GatheringMetrics
+{
+public:
+    static GatheringMetrics* instance();
+    ~GatheringMetrics();
+
+    // Starts, reconfigures or (with an empty path) pauses the writer
+    void Configure(std::string const& path, uint32 interval);
+    void Stop();
+
+    void OnLoot(uint8 profession);
+    void OnExperience(uint8 profession, uint32 xp, uint8 cohort);
+    void OnEdit(uint8 changeType);
+    void OnReload(uint64 microseconds);
+
+    // Gathers and XP of an experiment cohort for a profession, since startup or the last clear
+    uint64 GetCohortGathers(uint8 cohort, uint8 profession) const { return cohortGathers[cohort][profession - 1].load(std::memory_order_relaxed); }
+    uint64 GetCohortXP(uint8 cohort, uint8 profession) const { return cohortXP[cohort][profession - 1].load(std::memory_order_relaxed); }
+    void ClearCohorts();
+
+private:
+    static constexpr std::array<uint64, 7> RELOAD_BUCKETS{ 10000, 50000, 100000, 250000, 500000, 1000000, 5000000 }; // microseconds
+    static constexpr uint8 EDIT_TYPE_COUNT = 4;
+
+    void Run();
+    std::string Render() const;
+    bool Write(std::string const& path, std::string const& text) const;
+
+    std::atomic<uint64> lootEvents{0};
+    std::atomic<uint64> lootMisses{0};
+    std::array<std::atomic<uint64>, GATHERING_PROFESSION_COUNT> lootHits{};
+    std::array<std::atomic<uint64>, GATHERING_PROFESSION_COUNT> xpAwarded{};
+    std::array<std::atomic<uint64>, EDIT_TYPE_COUNT> edits{};
+    std::array<std::atomic<uint64>, RELOAD_BUCKETS.size()> reloadBuckets{};
+    std::atomic<uint64> reloadCount{0};
+    std::atomic<uint64> reloadMicroseconds{0};
+    std::array<std::array<std::atomic<uint64>, GATHERING_PROFESSION_COUNT>, GATHERING_MAX_COHORTS> cohortGathers{};
+    std::array<std::array<std::atomic<uint64>, GATHERING_PROFESSION_COUNT>, GATHERING_MAX_COHORTS> cohortXP{};
+
+    std::thread writer;
+    std::mutex configLock;
+    std::condition_variable wakeup;
+    std::string filePath;
+    uint32 writeInterval{15};
+    bool stopping{false};
+};
+
+#define sGatheringMetrics GatheringMetrics::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_METRICS_H
@@ -0,0 +1,210 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringNotify.h"
+#include "Chat.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "Timer.h"
+#include <algorithm>
+
+namespace
+{
+    // 1240 -> "1,240"
+    std::string FormatXP(uint32 xp)
+    {
+        std::string digits = std::to_string(xp);
+        for (int32 i = static_cast<int32>(digits.size()) - 3; i > 0; i -= 3)
+            digits.insert(i, ",");
+        return digits;
+    }
+}
+
+GatheringNotify* GatheringNotify::instance()
+{
+    static GatheringNotify instance;
+    return &instance;
+}
+
+GatheringNotify::GatheringNotify()
+{
+    for (uint32 i = 0; i < QUEUE_SIZE; ++i)
+        queue[i].sequence.store(i, std::memory_order_relaxed);
+    pending.reserve(QUEUE_SIZE);
+}
+
+bool GatheringNotify::Push(QueuedNotice const& notice)
+{
+    uint32 position = pushPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        QueueSlot& slot = queue[position % QUEUE_SIZE];
+        int32 lag = static_cast<int32>(slot.sequence.load(std::memory_order_acquire) - position);
+        if (lag < 0)
+            return false; // Full, the world thread has not reached this slot yet
+
+        if (lag > 0)
+            position = pushPosition.load(std::memory_order_relaxed);
+        else if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+            slot.notice = notice;
+            slot.sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+bool GatheringNotify::Pop(QueuedNotice& notice)
+{
+    QueueSlot& slot = queue[popPosition % QUEUE_SIZE];
+    if (slot.sequence.load(std::memory_order_acquire) != popPosition + 1)
+        return false;
+
+    notice = slot.notice;
+    slot.sequence.store(popPosition + QUEUE_SIZE, std::memory_order_release);
+    ++popPosition;
+    return true;
+}
+
+void GatheringNotify::LoadConfig()
+{
+    enabled = sConfigMgr->GetOption<bool>("GatheringExperience.Notify.Enable", true);
+    window = sConfigMgr->GetOption<uint32>("GatheringExperience.Notify.Window", 1000);
+    cooldown = sConfigMgr->GetOption<uint32>("GatheringExperience.Notify.Cooldown", 5000);
+}
+
+void GatheringNotify::LoadPlayerPreferences(GatheringPlayerData& data, Field* fields)
+{
+    // Null without a row, all preferences at their default
+    if (!fields[0].IsNull())
+        data.preferences = std::bitset<GATHERING_PREF_COUNT>(fields[0].Get<uint32>());
+}
+
+void GatheringNotify::SetShowXP(Player* player, bool show)
+{
+    GatheringPlayerData* data = GatheringPlayerData::Get(player);
+    if (!data)
+        return;
+
+    data->preferences.set(GATHERING_PREF_HIDE_XP, !show);
+    // Drop what is pending, a queued entry then has nothing to send
+    data->notice.xp = 0;
+    data->notice.professions = 0;
+    data->notice.rarity = 0;
+
+    uint32 guid = player->GetGUID().GetCounter();
+    if (data->preferences.none())
+        CharacterDatabase.Execute("DELETE FROM character_gathering_preferences WHERE guid = {}", guid);
+    else
+        CharacterDatabase.Execute("REPLACE INTO character_gathering_preferences (guid, flags) VALUES ({}, {})", guid, data->preferences.to_ulong());
+}
+
+void GatheringNotify::DeleteCharacterPreferences(ObjectGuid guid)
+{
+    CharacterDatabase.Execute("DELETE FROM character_gathering_preferences WHERE guid = {}", guid.GetCounter());
+}
+
+void GatheringNotify::OnExperience(GatheringGatherer const& gatherer, uint8 profession, uint8 rarity, uint32 xp)
+{
+    if (!enabled || !xp || profession < PROF_MINING || profession > PROF_FISHING)
+        return;
+
+    GatheringPlayerData* data = gatherer.data;
+    if (!data || data->preferences.test(GATHERING_PREF_HIDE_XP))
+        return;
+
+    GatheringXPNotice& notice = data->notice;
+    notice.xp += xp;
+    notice.professions |= 1 << (profession - 1);
+    notice.rarity = std::max(notice.rarity, rarity);
+    Queue(gatherer.guid, notice);
+}
+
+void GatheringNotify::OnCapReached(GatheringGatherer const& gatherer, GatheringCapReached cap)
+{
+    GatheringPlayerData* data = gatherer.data;
+    if (!data)
+        return;
+
+    data->notice.capReached = std::max<uint8>(data->notice.capReached, cap);
+    Queue(gatherer.guid, data->notice);
+}
+
+void GatheringNotify::Queue(ObjectGuid guid, GatheringXPNotice& notice)
+{
+    if (notice.queued)
+        return;
+
+    // The first gather opens the window. All items of a loot window arrive
+    // together, so it closes shortly after, or later while the player's
+    // last message is still within the cooldown.
+    uint32 now = getMSTime();
+    uint32 delay = window;
+    if (notice.lastSentTime)
+    {
+        uint32 sinceLast = getMSTimeDiff(notice.lastSentTime, now);
+        if (sinceLast < cooldown)
+            delay = std::max(delay, cooldown - sinceLast);
+    }
+
+    // A full queue leaves the player unqueued, the XP stays pending and
+    // the next gather tries again
+    notice.queued = Push({ guid, now, delay });
+}
+
+void GatheringNotify::Update()
+{
+    for (QueuedNotice entry; Pop(entry); )
+        pending.push_back(entry);
+
+    if (pending.empty())
+        return;
+
+    // Runs between map updates, so the players' slots are not being written
+    uint32 now = getMSTime();
+    std::erase_if(pending, [this, now](QueuedNotice const& entry)
+    {
+        if (getMSTimeDiff(entry.queuedTime, now) < entry.delay)
+            return false;
+
+        Player* player = ObjectAccessor::FindConnectedPlayer(entry.guid);
+        GatheringPlayerData* data = player ? GatheringPlayerData::Get(player) : nullptr;
+        if (data)
+        {
+            data->notice.queued = false;
+            if (data->notice.xp || data->notice.capReached)
+                Send(player, data->notice);
+        }
+        return true;
+    });
+}
+
+void GatheringNotify::Send(Player* player, GatheringXPNotice& notice)
+{
+    static char const* const professionNames[GATHERING_PROFESSION_COUNT] = { "Mining", "Herbalism", "Skinning", "Fishing" };
+
+    ChatHandler handler(player->GetSession());
+    if (notice.xp)
+    {
+        std::string sources;
+        for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+            if (notice.professions & (1 << i))
+                sources += (sources.empty() ? "" : ", ") + std::string(professionNames[i]);
+
+        if (notice.rarity)
+            sources += notice.rarity == 1 ? ", Uncommon bonus" : ", Rare bonus";
+
+        handler.PSendSysMessage("+{} gathering XP ({})", FormatXP(notice.xp), sources);
+    }
+
+    if (notice.capReached == GATHERING_CAP_TOTAL)
+        handler.SendSysMessage("You have reached today's gathering experience limit.");
+    else if (notice.capReached == GATHERING_CAP_PROFESSION)
+        handler.SendSysMessage("You have reached today's gathering experience limit for this profession.");
+
+    notice = GatheringXPNotice();
+    notice.lastSentTime = getMSTime();
+}
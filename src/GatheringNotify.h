@@ -0,0 +1,75 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_NOTIFY_H
+#define MODULE_GATHERING_EXPERIENCE_NOTIFY_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+#include <atomic>
+#include <vector>
+
+// Tells players the gathering XP they earned, one message per loot window
+// instead of one per item. Gathers only add to a counter in the player's
+// data slot; the first one queues the player, and the world update sends
+// the total once the window has closed and the player's cooldown passed.
+class GatheringNotify
+{
+public:
+    // Players queued between two world updates; more wait for their next gather
+    static const uint32 QUEUE_SIZE = 4096;
+
+    static GatheringNotify* instance();
+
+    void LoadConfig();
+    bool IsEnabled() const { return enabled; }
+
+    // Preference column of the login query, see GatheringPlayerData::Load
+    void LoadPlayerPreferences(GatheringPlayerData& data, Field* fields);
+    void SetShowXP(Player* player, bool show);
+    void DeleteCharacterPreferences(ObjectGuid guid);
+
+    // Loot path, adds XP to the player's pending message
+    void OnExperience(GatheringGatherer const& gatherer, uint8 profession, uint8 rarity, uint32 xp);
+
+    // Loot path, a daily cap was hit; told even with notices off
+    void OnCapReached(GatheringGatherer const& gatherer, GatheringCapReached cap);
+
+    // Sends messages that are due, world thread only
+    void Update();
+
+private:
+    struct QueuedNotice
+    {
+        ObjectGuid guid;
+        uint32 queuedTime;
+        uint32 delay;
+    };
+
+    // Bounded queue with a sequence number per slot: map threads claim a
+    // slot with one compare and swap, the world thread is the only reader
+    struct QueueSlot
+    {
+        std::atomic<uint32> sequence;
+        QueuedNotice notice;
+    };
+
+    GatheringNotify();
+
+    void Queue(ObjectGuid guid, GatheringXPNotice& notice);
+    bool Push(QueuedNotice const& notice);
+    bool Pop(QueuedNotice& notice);
+    void Send(Player* player, GatheringXPNotice& notice);
+
+    bool enabled{true};
+    uint32 window{1000};
+    uint32 cooldown{5000};
+
+    std::array<QueueSlot, QUEUE_SIZE> queue;
+    std::atomic<uint32> pushPosition{0};
+    uint32 popPosition{0};
+
+    // Popped and still inside their window, world thread only
+    std::vector<QueuedNotice> pending;
+};
+
+#define sGatheringNotify GatheringNotify::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_NOTIFY_H
@@ -0,0 +1,78 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringPlayerData.h"
+#include "GatheringCaps.h"
+#include "GatheringNotify.h"
+#include "GatheringRates.h"
+#include "GatheringStats.h"
+#include "DatabaseEnv.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+
+std::string const GatheringPlayerData::KEY = "GatheringExp";
+
+namespace
+{
+    QueryCallbackProcessor loadProcessor;
+    uint32 lastLoadId = 0;
+}
+
+GatheringPlayerData* GatheringPlayerData::Get(Player* player)
+{
+    GatheringPlayerData* data = player->CustomData.Get<GatheringPlayerData>(KEY);
+    return data && data->loaded ? data : nullptr;
+}
+
+void GatheringPlayerData::Load(Player* player)
+{
+    GatheringPlayerData* data = new GatheringPlayerData();
+    data->loadId = ++lastLoadId;
+    player->CustomData.Set(KEY, data);
+
+    // One row per profession with stats, at least one; the single row tables
+    // repeat on each. Columns 0-1 rates, 2-7 daily XP, 8 preferences, 9-12 stats.
+    uint32 guid = player->GetGUID().GetCounter();
+    std::string query = Acore::StringFormat(
+        "SELECT (SELECT multiplier FROM account_gathering_rate WHERE account_id = {}), "
+        "(SELECT multiplier FROM character_gathering_rate WHERE guid = {}), "
+        "d.reset_time, d.mining_xp, d.herbalism_xp, d.skinning_xp, d.fishing_xp, d.total_xp, "
+        "(SELECT flags FROM character_gathering_preferences WHERE guid = {}), "
+        "s.profession, s.gathers, s.xp_earned, s.last_item_id "
+        "FROM (SELECT 1) AS login "
+        "LEFT JOIN character_gathering_daily d ON d.guid = {} "
+        "LEFT JOIN character_gathering_stats s ON s.guid = {}",
+        player->GetSession()->GetAccountId(), guid, guid, guid, guid);
+
+    loadProcessor.AddCallback(CharacterDatabase.AsyncQuery(query).WithCallback(
+        [playerGuid = player->GetGUID(), loadId = data->loadId](QueryResult result)
+    {
+        Player* player = ObjectAccessor::FindConnectedPlayer(playerGuid);
+        if (!player)
+            return;
+
+        GatheringPlayerData* data = player->CustomData.Get<GatheringPlayerData>(KEY);
+        if (!data || data->loadId != loadId)
+            return;
+
+        if (result)
+        {
+            Field* fields = result->Fetch();
+            sGatheringRates->LoadPlayerRates(*data, fields);
+            sGatheringCaps->LoadPlayerXP(*data, fields + 2);
+            sGatheringNotify->LoadPlayerPreferences(*data, fields + 8);
+
+            do
+                sGatheringStats->LoadPlayerStats(*data, result->Fetch() + 9);
+            while (result->NextRow());
+        }
+
+        data->loaded = true;
+    }));
+}
+
+void GatheringPlayerData::ProcessLoads()
+{
+    loadProcessor.ProcessReadyCallbacks();
+}
@@ -0,0 +1,121 @@
+#ifndef GATHERING_PLAYER_DATA_H
+#define GATHERING_PLAYER_DATA_H
+
+#include "DataMap.h"
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <array>
+#include <bitset>
+#include <string>
+
+class Player;
+
+const uint8 GATHERING_PROFESSION_COUNT = 4;
+
+// Per-player switches, saved as a bit mask; all clear is the default
+enum GatheringPreference
+{
+    GATHERING_PREF_HIDE_XP = 0, // No gathering XP notifications
+    GATHERING_PREF_COUNT
+};
+
+struct GatheringProfessionStats
+{
+    uint32 gathers{0};
+    uint64 xpEarned{0};
+    uint32 lastItemId{0};
+    bool dirty{false};
+};
+
+// Streaming gather-rate statistics used by the bot detector
+struct GatheringRateTracker
+{
+    uint64 lastLootGuid{0};
+    uint32 lastGatherTime{0};
+    uint32 samples{0};
+    float decayedCount{0.0f};  // Gathers, halved every half-life
+    float intervalMean{0.0f};  // Exponentially weighted, milliseconds
+    float intervalVariance{0.0f};
+    uint32 lastReportTime{0};
+    bool flagged{false};
+};
+
+// XP awarded since the last daily reset. The counters belong to the day
+// ending at resetTime and are cleared when first touched on a later day.
+struct GatheringDailyXP
+{
+    uint32 resetTime{0};
+    std::array<uint32, GATHERING_PROFESSION_COUNT> professionXP{};
+    uint32 totalXP{0};
+    bool dirty{false};
+};
+
+// Daily limit a gather ran into, told to the player with the next notice
+enum GatheringCapReached : uint8
+{
+    GATHERING_CAP_NONE       = 0,
+    GATHERING_CAP_PROFESSION = 1,
+    GATHERING_CAP_TOTAL      = 2
+};
+
+// Gathering XP the player has not been told about yet
+struct GatheringXPNotice
+{
+    uint32 xp{0};
+    uint32 lastSentTime{0};
+    uint8 professions{0}; // Bit per profession id - 1
+    uint8 rarity{0};      // Highest of the gathers
+    uint8 capReached{GATHERING_CAP_NONE};
+    bool queued{false};
+};
+
+// Per-player module state, attached to Player::CustomData for the time the
+// player is online. Only the thread updating the player touches it.
+class GatheringPlayerData : public DataMap::Base
+{
+public:
+    // Indexed by profession id - 1
+    std::array<GatheringProfessionStats, GATHERING_PROFESSION_COUNT> stats;
+    GatheringRateTracker rate;
+    GatheringDailyXP daily;
+    GatheringXPNotice notice;
+    std::bitset<GATHERING_PREF_COUNT> preferences;
+
+    // XP rate overrides, loaded on login
+    float accountRate{1.0f};
+    float characterRate{1.0f};
+
+    // Null until the player's data has been loaded on login
+    static GatheringPlayerData* Get(Player* player);
+
+    // Attaches an empty slot and reads all of the character's rows with one
+    // asynchronous query; Get returns the slot once the rows are in
+    static void Load(Player* player);
+
+    // Applies finished login queries, world thread only
+    static void ProcessLoads();
+
+private:
+    static std::string const KEY;
+
+    // Which login the slot belongs to, so a late result of an earlier login
+    // of the same character is dropped
+    uint32 loadId{0};
+    bool loaded{false};
+};
+
+// The player side of one gather, read from the Player once per loot. The
+// stress test fills it in for mock players.
+struct GatheringGatherer
+{
+    ObjectGuid guid;
+    GatheringPlayerData* data{nullptr}; // Null until loaded on login
+    uint32 level{0};
+    uint32 skill{0};                    // In the gathered item's profession
+    uint32 zoneId{0};
+    float x{0.0f};
+    float y{0.0f};
+    bool sandbox{false};                // Mock player: scored, but nothing shared or saved is recorded
+};
+
+#endif // GATHERING_PLAYER_DATA_H
@@ -0,0 +1,135 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringProfiler.h"
+
+#ifdef GATHERING_EXPERIENCE_PROFILING
+
+#include "StringFormat.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct ProfileEvent
+    {
+        GatheringProfiler::CallSite const* site;
+        uint64 start;
+        uint64 duration;
+    };
+
+    // Single writer ring; the dump may race with the writer and see a
+    // partially overwritten oldest event, which is acceptable for profiling
+    struct ThreadBuffer
+    {
+        static constexpr uint64 CAPACITY = 1 << 14;
+
+        std::array<ProfileEvent, CAPACITY> events;
+        std::atomic<uint64> head{0};
+        uint32 threadId{0};
+    };
+
+    std::mutex registryLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        // Buffers outlive their threads so a dump still sees finished workers
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> guard(registryLock);
+            registry.push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry.back().get();
+            buffer->threadId = static_cast<uint32>(registry.size());
+        }
+        return *buffer;
+    }
+
+    uint64 Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::string EscapeJson(char const* text)
+    {
+        std::string escaped;
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                escaped += '\\';
+            escaped += *text;
+        }
+        return escaped;
+    }
+}
+
+GatheringProfiler::Scope::Scope(CallSite const& site) : site(site), start(Now()) { }
+
+GatheringProfiler::Scope::~Scope()
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    uint64 head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % ThreadBuffer::CAPACITY] = { &site, start, Now() - start };
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool GatheringProfiler::DumpChromeTrace(std::string const& path, uint32& events)
+{
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+
+    events = 0;
+    out << "{\"traceEvents\":[";
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (auto const& buffer : registry)
+    {
+        uint64 head = buffer->head.load(std::memory_order_acquire);
+        uint64 first = head > ThreadBuffer::CAPACITY ? head - ThreadBuffer::CAPACITY : 0;
+
+        for (uint64 i = first; i < head; ++i)
+        {
+            ProfileEvent const& event = buffer->events[i % ThreadBuffer::CAPACITY];
+            out << (events++ ? ",\n" : "\n") << Acore::StringFormat(
+                "{{\"name\":\"{}\",\"cat\":\"gathering\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},"
+                "\"args\":{{\"file\":\"{}\",\"line\":{}}}}}",
+                EscapeJson(event.site->name), event.start / 1000.0, event.duration / 1000.0, buffer->threadId,
+                EscapeJson(event.site->file), event.site->line);
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return bool(out);
+}
+
+void GatheringProfiler::Clear()
+{
+    std::lock_guard<std::mutex> guard(registryLock);
+    for (auto const& buffer : registry)
+        buffer->head.store(0, std::memory_order_relaxed);
+}
+
+#else
+
+bool GatheringProfiler::DumpChromeTrace(std::string const& /*path*/, uint32& events)
+{
+    events = 0;
+    return false;
+}
+
+void GatheringProfiler::Clear() { }
+
+#endif
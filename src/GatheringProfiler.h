@@ -0,0 +1,71 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_PROFILER_H
+#define MODULE_GATHERING_EXPERIENCE_PROFILER_H
+
+#include "Define.h"
+#include <string>
+
+// Scoped timers for the module's entry points. Build with
+// GATHERING_EXPERIENCE_PROFILING defined to enable them; otherwise
+// GE_PROFILE_SCOPE expands to nothing.
+//
+// Each thread records into its own fixed-size ring buffer, so recording
+// takes no lock. The buffers can be dumped as Chrome trace-event JSON and
+// opened in chrome://tracing or Perfetto.
+
+#define GE_PROFILE_CONCAT_INNER(a, b) a##b
+#define GE_PROFILE_CONCAT(a, b) GE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef GATHERING_EXPERIENCE_PROFILING
+
+#define GE_PROFILE_SCOPE(name) \
+    static GatheringProfiler::CallSite const GE_PROFILE_CONCAT(geProfileSite, __LINE__){ name, __FILE__, __LINE__ }; \
+    GatheringProfiler::Scope GE_PROFILE_CONCAT(geProfileScope, __LINE__)(GE_PROFILE_CONCAT(geProfileSite, __LINE__))
+
+namespace GatheringProfiler
+{
+    struct CallSite
+    {
+        char const* name;
+        char const* file;
+        uint32 line;
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(CallSite const& site);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        CallSite const& site;
+        uint64 start;
+    };
+}
+
+#else
+
+#define GE_PROFILE_SCOPE(name) ((void)0)
+
+#endif
+
+namespace GatheringProfiler
+{
+    constexpr bool IsEnabled()
+    {
+#ifdef GATHERING_EXPERIENCE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Writes every buffered scope to a Chrome trace file, returns false if
+    // the file cannot be written or profiling is compiled out
+    bool DumpChromeTrace(std::string const& path, uint32& events);
+    void Clear();
+}
+
+#endif //MODULE_GATHERING_EXPERIENCE_PROFILER_H
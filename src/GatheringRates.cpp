@@ -0,0 +1,60 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringRates.h"
+#include "GatheringPlayerData.h"
+#include "DatabaseEnv.h"
+#include "Player.h"
+
+GatheringRates* GatheringRates::instance()
+{
+    static GatheringRates instance;
+    return &instance;
+}
+
+void GatheringRates::LoadPlayerRates(GatheringPlayerData& data, Field* fields)
+{
+    // Account then character multiplier, null without an override
+    data.accountRate = fields[0].IsNull() ? 1.0f : std::max(fields[0].Get<float>(), 0.0f);
+    data.characterRate = fields[1].IsNull() ? 1.0f : std::max(fields[1].Get<float>(), 0.0f);
+}
+
+void GatheringRates::SetAccountRate(Player* player, float rate)
+{
+    uint32 accountId = player->GetSession()->GetAccountId();
+    if (rate == 1.0f)
+        CharacterDatabase.Execute("DELETE FROM account_gathering_rate WHERE account_id = {}", accountId);
+    else
+        CharacterDatabase.Execute("REPLACE INTO account_gathering_rate (account_id, multiplier) VALUES ({}, {})", accountId, rate);
+
+    if (GatheringPlayerData* data = GatheringPlayerData::Get(player))
+        data->accountRate = rate;
+}
+
+void GatheringRates::SetCharacterRate(Player* player, float rate)
+{
+    uint32 guid = player->GetGUID().GetCounter();
+    if (rate == 1.0f)
+        CharacterDatabase.Execute("DELETE FROM character_gathering_rate WHERE guid = {}", guid);
+    else
+        CharacterDatabase.Execute("REPLACE INTO character_gathering_rate (guid, multiplier) VALUES ({}, {})", guid, rate);
+
+    if (GatheringPlayerData* data = GatheringPlayerData::Get(player))
+        data->characterRate = rate;
+}
+
+void GatheringRates::DeleteCharacterRate(ObjectGuid guid)
+{
+    CharacterDatabase.Execute("DELETE FROM character_gathering_rate WHERE guid = {}", guid.GetCounter());
+}
+
+float GatheringRates::GetRate(Player* player) const
+{
+    return GetRate(GatheringPlayerData::Get(player));
+}
+
+float GatheringRates::GetRate(GatheringPlayerData const* data) const
+{
+    return data ? data->accountRate * data->characterRate : 1.0f;
+}
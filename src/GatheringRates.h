@@ -0,0 +1,27 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_RATES_H
+#define MODULE_GATHERING_EXPERIENCE_RATES_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+
+// Per-account and per-character XP multipliers. Both are read once on login
+// into the player's data slot, so looting never queries the database.
+class GatheringRates
+{
+public:
+    static GatheringRates* instance();
+
+    // Rate columns of the login query, see GatheringPlayerData::Load
+    void LoadPlayerRates(GatheringPlayerData& data, Field* fields);
+    void SetAccountRate(Player* player, float rate);
+    void SetCharacterRate(Player* player, float rate);
+    void DeleteCharacterRate(ObjectGuid guid);
+
+    // Combined multiplier, 1 for players without a loaded slot
+    float GetRate(Player* player) const;
+    float GetRate(GatheringPlayerData const* data) const;
+};
+
+#define sGatheringRates GatheringRates::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_RATES_H
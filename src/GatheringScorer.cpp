@@ -0,0 +1,99 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringScorer.h"
+#include "GatheringAntiBot.h"
+#include "GatheringCapture.h"
+#include "GatheringCaps.h"
+#include "GatheringEvents.h"
+#include "GatheringHeatmap.h"
+#include "GatheringMetrics.h"
+#include "GatheringNotify.h"
+#include "GatheringRates.h"
+#include "GatheringStats.h"
+#include "Config.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+
+GatheringScorer* GatheringScorer::instance()
+{
+    static GatheringScorer instance;
+    return &instance;
+}
+
+void GatheringScorer::LoadConfig()
+{
+    cohortSeed = sConfigMgr->GetOption<uint32>("GatheringExperience.Cohorts.Seed", 0);
+    ineligibleZoneFactor = std::max(0.0f, sConfigMgr->GetOption<float>("GatheringExperience.ItemZones.Factor", 0.0f));
+}
+
+uint32 GatheringScorer::Score(GatheringGatherer const& gatherer, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item, uint32 count, uint32 xpGained, ObjectGuid lootguid, float nodeFactor)
+{
+    uint8 profession = item.profession;
+
+    // Scheduled XP events and account/character rate overrides
+    float multiplier = sGatheringEvents->GetMultiplier(profession, gatherer.zoneId) * sGatheringRates->GetRate(gatherer.data);
+
+    // XP experiment cohort, none unless cohorts are configured
+    uint8 cohort = 0;
+    if (!data.cohortMultipliers.empty())
+    {
+        cohort = data.GetCohort(gatherer.guid.GetCounter(), cohortSeed);
+        multiplier *= data.cohortMultipliers[cohort][profession - 1];
+    }
+
+    // Loot the item does not naturally gather in here, e.g. fish caught
+    // elsewhere. Nodes are always harvested where they stand.
+    if (!lootguid.IsEmpty() && !data.zoneEligibility.empty())
+    {
+        if (!data.zoneEligibility.IsEligible(data.items.IndexOf(item), gatherer.zoneId))
+        {
+            LOG_DEBUG("module", "Item {} looted by player {} outside its gathering zones (zone {})", itemId, gatherer.guid.GetCounter(), gatherer.zoneId);
+            multiplier *= ineligibleZoneFactor;
+        }
+    }
+
+    if (multiplier != 1.0f)
+        xpGained = std::min(static_cast<uint32>(xpGained * multiplier), MAX_EXPERIENCE_GAIN);
+
+    // Withhold XP from players the bot detector currently flags
+    bool withheld = sGatheringAntiBot->OnGather(gatherer, lootguid);
+
+    if (!gatherer.sandbox && sGatheringCapture->IsEnabled())
+    {
+        GatheringCaptureRecord record{};
+        record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        record.playerGuid = gatherer.guid.GetRawValue();
+        record.itemId = itemId;
+        record.zoneId = gatherer.zoneId;
+        record.xp = xpGained;
+        record.multiplier = multiplier;
+        record.nodeFactor = nodeFactor;
+        record.skill = gatherer.skill;
+        record.count = std::min<uint32>(count, 255);
+        record.level = gatherer.level;
+        record.profession = profession;
+        record.flags = (lootguid.IsEmpty() ? GATHERING_CAPTURE_NODE : 0) | (withheld ? GATHERING_CAPTURE_WITHHELD : 0);
+        sGatheringCapture->Record(record);
+    }
+
+    if (withheld)
+        xpGained = 0;
+    else
+        xpGained = sGatheringCaps->Apply(gatherer, profession, xpGained);
+
+    // Everything below is shared with real players or saved
+    if (gatherer.sandbox)
+        return xpGained;
+
+    sGatheringMetrics->OnExperience(profession, xpGained, cohort);
+    sGatheringHeatmap->Record(gatherer.zoneId, gatherer.x, gatherer.y, profession, xpGained);
+
+    if (xpGained > 0 && sGatheringNotify->IsEnabled())
+        sGatheringNotify->OnExperience(gatherer, profession, item.rarity, xpGained);
+
+    sGatheringStats->RecordGather(gatherer, profession, itemId, xpGained);
+    return xpGained;
+}
@@ -0,0 +1,37 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_SCORER_H
+#define MODULE_GATHERING_EXPERIENCE_SCORER_H
+
+#include "GatheringPlayerData.h"
+#include "engine/GatheringSnapshot.h"
+
+// Everything between the formula and the player's XP bar that needs no
+// Player: multipliers, the bot check, the capture, the daily caps, and the
+// metrics, heatmap, notices and stats the XP is recorded in. The loot path
+// and the stress test's mock players both score gathers here, and the
+// allocation test links it against stub server headers.
+class GatheringScorer
+{
+public:
+    static GatheringScorer* instance();
+
+    void LoadConfig();
+
+    // Applies multipliers, the bot check and the daily caps, then records
+    // and announces the XP; returns what is left to give. item is itemId's
+    // entry in data. Sandboxed gathers stop before anything is recorded.
+    uint32 Score(GatheringGatherer const& gatherer, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item, uint32 count, uint32 xpGained, ObjectGuid lootguid, float nodeFactor = 1.0f);
+
+    uint32 GetCohortSeed() const { return cohortSeed; }
+    float GetIneligibleZoneFactor() const { return ineligibleZoneFactor; }
+
+private:
+    // Reshuffles players between XP experiment cohorts
+    uint32 cohortSeed{0};
+
+    // XP factor for loot outside the zones listed for the item
+    float ineligibleZoneFactor{0.0f};
+};
+
+#define sGatheringScorer GatheringScorer::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_SCORER_H
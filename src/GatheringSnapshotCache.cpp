@@ -0,0 +1,292 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringSnapshotCache.h"
+#include "Log.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    // On-disk layout: header, item records, zone records, rarity records,
+    // setting records, cohort records, item zone records, then the item name
+    // bytes. All records are fixed size.
+    struct CacheHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 dbChecksum;
+        uint64 payloadHash;
+        uint32 itemCount;
+        uint32 zoneCount;
+        uint32 rarityCount;
+        uint32 settingCount;
+        uint32 nameBytes;
+        uint32 cohortCount;
+        uint32 itemZoneCount;
+        uint32 reserved;
+    };
+
+    struct ItemRecord
+    {
+        uint32 itemId;
+        uint32 baseXP;
+        uint32 requiredSkill;
+        uint32 recommendedLevel;
+        uint32 nameOffset;
+        uint16 nameLength;
+        uint8 profession;
+        uint8 rarity;
+    };
+
+    struct MultiplierRecord
+    {
+        uint32 id;
+        float multiplier;
+    };
+
+    struct SettingRecord
+    {
+        uint8 profession;
+        uint8 enabled;
+        uint8 padding[2];
+    };
+
+    struct CohortRecord
+    {
+        float multipliers[4];
+    };
+
+    struct ItemZoneRecord
+    {
+        uint32 itemId;
+        uint32 zoneId;
+    };
+
+    static_assert(sizeof(CacheHeader) == 56, "snapshot cache header layout changed");
+    static_assert(sizeof(ItemRecord) == 24, "snapshot cache item layout changed");
+    static_assert(sizeof(MultiplierRecord) == 8, "snapshot cache multiplier layout changed");
+    static_assert(sizeof(SettingRecord) == 4, "snapshot cache setting layout changed");
+    static_assert(sizeof(CohortRecord) == 16, "snapshot cache cohort layout changed");
+    static_assert(sizeof(ItemZoneRecord) == 8, "snapshot cache item zone layout changed");
+
+    template<typename T>
+    void Append(std::vector<char>& buffer, T const& value)
+    {
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    T Read(char const*& cursor)
+    {
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+}
+
+uint64 GatheringSnapshotCache::Hash(void const* data, std::size_t size, uint64 seed)
+{
+    // FNV-1a, only used to detect a truncated or corrupted file
+    uint8 const* bytes = static_cast<uint8 const*>(data);
+    uint64 hash = seed;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool GatheringSnapshotCache::Load(std::string const& path, uint64 dbChecksum, GatheringSnapshot& snapshot)
+{
+    namespace bip = boost::interprocess;
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error) || std::filesystem::file_size(path, error) < sizeof(CacheHeader))
+        return false;
+
+    try
+    {
+        bip::file_mapping mapping(path.c_str(), bip::read_only);
+        bip::mapped_region region(mapping, bip::read_only);
+
+        char const* data = static_cast<char const*>(region.get_address());
+        std::size_t size = region.get_size();
+
+        CacheHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
+        {
+            LOG_INFO("module", "Gathering snapshot cache {} has an unknown format, ignoring it", path);
+            return false;
+        }
+
+        if (header.dbChecksum != dbChecksum)
+            return false;
+
+        std::size_t payloadSize =
+            std::size_t(header.itemCount) * sizeof(ItemRecord) +
+            std::size_t(header.zoneCount) * sizeof(MultiplierRecord) +
+            std::size_t(header.rarityCount) * sizeof(MultiplierRecord) +
+            std::size_t(header.settingCount) * sizeof(SettingRecord) +
+            std::size_t(header.cohortCount) * sizeof(CohortRecord) +
+            std::size_t(header.itemZoneCount) * sizeof(ItemZoneRecord) +
+            header.nameBytes;
+
+        char const* cursor = data + sizeof(header);
+        if (size != sizeof(header) + payloadSize || Hash(cursor, payloadSize) != header.payloadHash)
+        {
+            LOG_ERROR("module", "Gathering snapshot cache {} is corrupt, ignoring it", path);
+            return false;
+        }
+
+        char const* names = cursor + payloadSize - header.nameBytes;
+
+        for (uint32 i = 0; i < header.itemCount; ++i)
+        {
+            ItemRecord record = Read<ItemRecord>(cursor);
+            if (std::size_t(record.nameOffset) + record.nameLength > header.nameBytes)
+                return false;
+
+            GatheringItem item;
+            item.baseXP = static_cast<uint16>(record.baseXP);
+            item.requiredSkill = static_cast<uint16>(record.requiredSkill);
+            item.profession = record.profession;
+            item.rarity = record.rarity;
+            item.recommendedLevel = static_cast<uint8>(record.recommendedLevel);
+            snapshot.items.Set(record.itemId, item, std::string_view(names + record.nameOffset, record.nameLength));
+        }
+
+        for (uint32 i = 0; i < header.zoneCount; ++i)
+        {
+            MultiplierRecord record = Read<MultiplierRecord>(cursor);
+            snapshot.zoneMultipliers[record.id] = record.multiplier;
+        }
+
+        for (uint32 i = 0; i < header.rarityCount; ++i)
+        {
+            MultiplierRecord record = Read<MultiplierRecord>(cursor);
+            snapshot.rarityMultipliers[record.id] = record.multiplier;
+        }
+
+        for (uint32 i = 0; i < header.settingCount; ++i)
+        {
+            SettingRecord record = Read<SettingRecord>(cursor);
+            snapshot.professionSettings.emplace_back(record.profession, record.enabled != 0);
+        }
+
+        for (uint32 i = 0; i < header.cohortCount; ++i)
+        {
+            CohortRecord record = Read<CohortRecord>(cursor);
+            snapshot.cohortMultipliers.push_back({ record.multipliers[0], record.multipliers[1], record.multipliers[2], record.multipliers[3] });
+        }
+
+        for (uint32 i = 0; i < header.itemZoneCount; ++i)
+        {
+            ItemZoneRecord record = Read<ItemZoneRecord>(cursor);
+            snapshot.itemZones.emplace_back(record.itemId, record.zoneId);
+        }
+    }
+    catch (bip::interprocess_exception const& e)
+    {
+        LOG_ERROR("module", "Failed to map gathering snapshot cache {}: {}", path, e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool GatheringSnapshotCache::Save(std::string const& path, uint64 dbChecksum, GatheringSnapshot const& snapshot)
+{
+    std::vector<char> payload;
+    std::string names;
+
+    payload.reserve(snapshot.items.size() * sizeof(ItemRecord) +
+        (snapshot.zoneMultipliers.size() + snapshot.rarityMultipliers.size()) * sizeof(MultiplierRecord));
+
+    for (auto const& [itemId, item] : snapshot.items)
+    {
+        ItemRecord record{};
+        record.itemId = itemId;
+        record.baseXP = item.baseXP;
+        record.requiredSkill = item.requiredSkill;
+        record.recommendedLevel = item.recommendedLevel;
+        std::string_view name = snapshot.items.GetName(item);
+        record.nameOffset = static_cast<uint32>(names.size());
+        record.nameLength = static_cast<uint16>(std::min<std::size_t>(name.size(), UINT16_MAX));
+        record.profession = item.profession;
+        record.rarity = item.rarity;
+        names.append(name.substr(0, record.nameLength));
+        Append(payload, record);
+    }
+
+    for (auto const& [zoneId, multiplier] : snapshot.zoneMultipliers)
+        Append(payload, MultiplierRecord{ zoneId, multiplier });
+
+    for (auto const& [itemId, multiplier] : snapshot.rarityMultipliers)
+        Append(payload, MultiplierRecord{ itemId, multiplier });
+
+    for (auto const& [profession, enabled] : snapshot.professionSettings)
+        Append(payload, SettingRecord{ profession, uint8(enabled ? 1 : 0), { 0, 0 } });
+
+    for (auto const& multipliers : snapshot.cohortMultipliers)
+        Append(payload, CohortRecord{ { multipliers[0], multipliers[1], multipliers[2], multipliers[3] } });
+
+    for (auto const& [itemId, zoneId] : snapshot.itemZones)
+        Append(payload, ItemZoneRecord{ itemId, zoneId });
+
+    payload.insert(payload.end(), names.begin(), names.end());
+
+    CacheHeader header{};
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.dbChecksum = dbChecksum;
+    header.payloadHash = Hash(payload.data(), payload.size());
+    header.itemCount = static_cast<uint32>(snapshot.items.size());
+    header.zoneCount = static_cast<uint32>(snapshot.zoneMultipliers.size());
+    header.rarityCount = static_cast<uint32>(snapshot.rarityMultipliers.size());
+    header.settingCount = static_cast<uint32>(snapshot.professionSettings.size());
+    header.nameBytes = static_cast<uint32>(names.size());
+    header.cohortCount = static_cast<uint32>(snapshot.cohortMultipliers.size());
+    header.itemZoneCount = static_cast<uint32>(snapshot.itemZones.size());
+
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path(), error);
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            LOG_ERROR("module", "Failed to write gathering snapshot cache {}", tempPath);
+            return false;
+        }
+
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(payload.data(), payload.size());
+        if (!out)
+        {
+            LOG_ERROR("module", "Failed to write gathering snapshot cache {}", tempPath);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, target, error);
+    if (error)
+    {
+        LOG_ERROR("module", "Failed to replace gathering snapshot cache {}: {}", path, error.message());
+        return false;
+    }
+
+    return true;
+}
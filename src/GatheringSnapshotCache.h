@@ -0,0 +1,24 @@
+#ifndef GATHERING_SNAPSHOT_CACHE_H
+#define GATHERING_SNAPSHOT_CACHE_H
+
+#include "engine/GatheringSnapshot.h"
+
+// Binary on-disk copy of a GatheringSnapshot. The file is stamped with the
+// checksum of the source tables so a stale cache is never used.
+class GatheringSnapshotCache
+{
+public:
+    static constexpr uint32 CACHE_MAGIC = 0x53584547; // "GEXS"
+    static constexpr uint32 CACHE_VERSION = 3;
+
+    // Maps the file and fills the snapshot. Returns false if the file is
+    // missing, corrupt, from another version or built from other table data.
+    static bool Load(std::string const& path, uint64 dbChecksum, GatheringSnapshot& snapshot);
+
+    // Writes the snapshot next to the target and renames it into place.
+    static bool Save(std::string const& path, uint64 dbChecksum, GatheringSnapshot const& snapshot);
+
+    static uint64 Hash(void const* data, std::size_t size, uint64 seed = 14695981039346656037ULL);
+};
+
+#endif // GATHERING_SNAPSHOT_CACHE_H
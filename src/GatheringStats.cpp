@@ -0,0 +1,78 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringStats.h"
+#include "GatheringLeaderboard.h"
+#include "DatabaseEnv.h"
+#include "Player.h"
+
+GatheringStats* GatheringStats::instance()
+{
+    static GatheringStats instance;
+    return &instance;
+}
+
+void GatheringStats::LoadPlayerStats(GatheringPlayerData& data, Field* fields)
+{
+    // profession, gathers, xp_earned, last_item_id; null without any stats
+    if (fields[0].IsNull())
+        return;
+
+    uint8 profession = fields[0].Get<uint8>();
+    if (profession < PROF_MINING || profession > PROF_FISHING)
+        return;
+
+    GatheringProfessionStats& stats = data.stats[profession - 1];
+    stats.gathers = fields[1].Get<uint32>();
+    stats.xpEarned = fields[2].Get<uint64>();
+    stats.lastItemId = fields[3].Get<uint32>();
+}
+
+void GatheringStats::SavePlayerStats(Player* player)
+{
+    GatheringPlayerData* data = GatheringPlayerData::Get(player);
+    if (!data)
+        return;
+
+    std::string values;
+    for (uint8 i = 0; i < GATHERING_PROFESSION_COUNT; ++i)
+    {
+        GatheringProfessionStats& stats = data->stats[i];
+        if (!stats.dirty)
+            continue;
+
+        if (!values.empty())
+            values += ", ";
+        values += Acore::StringFormat("({}, {}, {}, {}, {})",
+            player->GetGUID().GetCounter(), i + 1, stats.gathers, stats.xpEarned, stats.lastItemId);
+        stats.dirty = false;
+    }
+
+    if (values.empty())
+        return;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    trans->Append("REPLACE INTO character_gathering_stats (guid, profession, gathers, xp_earned, last_item_id) VALUES " + values);
+    CharacterDatabase.CommitTransaction(trans);
+}
+
+void GatheringStats::DeleteCharacterStats(ObjectGuid guid)
+{
+    CharacterDatabase.Execute("DELETE FROM character_gathering_stats WHERE guid = {}", guid.GetCounter());
+    sGatheringLeaderboard->Remove(guid.GetCounter());
+}
+
+void GatheringStats::RecordGather(GatheringGatherer const& gatherer, uint8 profession, uint32 itemId, uint32 xp)
+{
+    if (profession < PROF_MINING || profession > PROF_FISHING || !gatherer.data)
+        return;
+
+    GatheringProfessionStats& stats = gatherer.data->stats[profession - 1];
+    ++stats.gathers;
+    stats.xpEarned += xp;
+    stats.lastItemId = itemId;
+    stats.dirty = true;
+
+    sGatheringLeaderboard->Update(gatherer.guid.GetCounter(), profession, stats.gathers, stats.xpEarned);
+}
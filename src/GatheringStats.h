@@ -0,0 +1,24 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_STATS_H
+#define MODULE_GATHERING_EXPERIENCE_STATS_H
+
+#include "GatheringExperience.h"
+#include "GatheringPlayerData.h"
+
+// Per-character gathering totals. Kept in memory while the character is
+// online and written to the characters database on save or logout only.
+class GatheringStats
+{
+public:
+    static GatheringStats* instance();
+
+    // One profession's row of the login query, see GatheringPlayerData::Load
+    void LoadPlayerStats(GatheringPlayerData& data, Field* fields);
+    void SavePlayerStats(Player* player);
+    void DeleteCharacterStats(ObjectGuid guid);
+
+    void RecordGather(GatheringGatherer const& gatherer, uint8 profession, uint32 itemId, uint32 xp);
+};
+
+#define sGatheringStats GatheringStats::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_STATS_H
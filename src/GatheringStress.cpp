@@ -0,0 +1,349 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringStress.h"
+#include "GatheringPlayerData.h"
+#include "GatheringScorer.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Far above any real character, so mock players never share a guid with one
+    constexpr ObjectGuid::LowType MOCK_GUID_BASE = 0xF0000000;
+
+    struct MockPlayer
+    {
+        ObjectGuid guid;
+        GatheringPlayerData data; // Never attached to a Player, never saved
+        GatheringPlayerState state;
+        float x;
+        float y;
+    };
+
+    bool IsProfessionEnabled(uint8 profession)
+    {
+        switch (profession)
+        {
+            case PROF_MINING:    return sGatheringExperience->IsMiningEnabled();
+            case PROF_HERBALISM: return sGatheringExperience->IsHerbalismEnabled();
+            case PROF_SKINNING:  return sGatheringExperience->IsSkinningEnabled();
+            case PROF_FISHING:   return sGatheringExperience->IsFishingEnabled();
+            default:             return false;
+        }
+    }
+
+    // OnLootItem for a mock player: the same lookups and formula, then the
+    // same scoring as AwardExperience, minus the Player calls. The gather
+    // is sandboxed, so it stays out of metrics, the heatmap, captures,
+    // notices, stats and leaderboards.
+    uint32 SimulateLoot(MockPlayer& player, uint32 itemId, ObjectGuid lootGuid)
+    {
+        auto data = sGatheringExperience->GetSnapshotFor(itemId);
+        GatheringItem const* item = data ? data->items.Find(itemId) : nullptr;
+        uint8 profession = item && item->profession >= PROF_MINING && item->profession <= PROF_FISHING ? item->profession : 0;
+
+        if (!profession || !IsProfessionEnabled(profession) || (sGatheringExperience->IsNodeMode() && profession != PROF_FISHING))
+            return 0;
+
+        uint32 xp = GatheringFormula::Compute(*item, GatheringFormula::MakeInput(*data, *item, player.state)).finalXP;
+
+        GatheringGatherer gatherer;
+        gatherer.guid = player.guid;
+        gatherer.data = &player.data;
+        gatherer.level = player.state.level;
+        gatherer.skill = player.state.skills[profession - 1];
+        gatherer.zoneId = player.state.zoneId;
+        gatherer.x = player.x;
+        gatherer.y = player.y;
+        gatherer.sandbox = true;
+        return sGatheringScorer->Score(gatherer, *data, itemId, *item, 1, xp, lootGuid);
+    }
+
+    // A mean interval jittered by +-50%, so the bot check sees human-like gathers
+    Clock::duration NextInterval(std::mt19937& rng, uint32 gatherInterval)
+    {
+        return std::chrono::microseconds(uint64(gatherInterval) * (500 + rng() % 1000));
+    }
+}
+
+void GatheringLatencyHistogram::Add(uint64 ns)
+{
+    uint32 value = static_cast<uint32>(std::min<uint64>(ns, std::numeric_limits<uint32>::max()));
+    ++buckets[GetBucket(value)];
+    ++count;
+    max = std::max(max, value);
+}
+
+void GatheringLatencyHistogram::Merge(GatheringLatencyHistogram const& other)
+{
+    for (uint32 i = 0; i < BUCKETS; ++i)
+        buckets[i] += other.buckets[i];
+    count += other.count;
+    max = std::max(max, other.max);
+}
+
+uint32 GatheringLatencyHistogram::GetPercentile(double fraction) const
+{
+    if (!count)
+        return 0;
+
+    uint64 rank = std::max<uint64>(static_cast<uint64>(fraction * count + 0.5), 1);
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BUCKETS; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(GetUpperEdge(i), max);
+    }
+    return max;
+}
+
+uint32 GatheringLatencyHistogram::GetBucket(uint32 ns)
+{
+    if (ns < 8)
+        return ns;
+
+    // Power of two, then which quarter of it
+    uint32 exponent = std::bit_width(ns) - 1;
+    return (exponent - 1) * 4 + ((ns >> (exponent - 2)) & 3);
+}
+
+uint32 GatheringLatencyHistogram::GetUpperEdge(uint32 bucket)
+{
+    if (bucket < 8)
+        return bucket;
+
+    uint32 exponent = bucket / 4 + 1;
+    uint64 lower = uint64(4 + bucket % 4) << (exponent - 2);
+    return static_cast<uint32>(lower + (uint64(1) << (exponent - 2)) - 1);
+}
+
+GatheringStress* GatheringStress::instance()
+{
+    static GatheringStress instance;
+    return &instance;
+}
+
+GatheringStress::~GatheringStress()
+{
+    if (worker.joinable())
+        worker.join();
+}
+
+void GatheringStress::LoadConfig()
+{
+    allowed = sConfigMgr->GetOption<bool>("GatheringExperience.Stress.Enable", false);
+}
+
+bool GatheringStress::Start(GatheringStressSettings const& settings)
+{
+    if (!allowed || running.exchange(true))
+        return false;
+
+    if (worker.joinable())
+        worker.join();
+    stopping = false;
+
+    {
+        std::lock_guard<std::mutex> guard(resultLock);
+        results.clear();
+    }
+
+    worker = std::thread(&GatheringStress::Run, this, settings);
+    return true;
+}
+
+void GatheringStress::Stop()
+{
+    stopping = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+std::vector<GatheringStressPhase> GatheringStress::GetResults() const
+{
+    std::lock_guard<std::mutex> guard(resultLock);
+    return results;
+}
+
+void GatheringStress::Run(GatheringStressSettings settings)
+{
+    LOG_INFO("module", "Gathering stress test: up to {} threads, {} events and {} mock players per thread, a gather every {} ms per player, an item edit every {} ms",
+        settings.maxThreads, settings.eventsPerThread, settings.playersPerThread, settings.gatherInterval, settings.editInterval);
+
+    std::vector<uint32> threadCounts;
+    for (uint32 threads = 1; threads < settings.maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(settings.maxThreads);
+
+    for (uint32 threads : threadCounts)
+    {
+        if (stopping)
+            break;
+
+        GatheringStressPhase phase = RunPhase(settings, threads);
+
+        LOG_INFO("module", "Gathering stress test: {} threads, {:.0f} events/s (paced at {:.0f}), p50 {} ns, p99 {} ns, p99.9 {} ns, max {} ns, {} edits",
+            phase.threads, phase.eventsPerSecond, phase.targetPerSecond, phase.p50, phase.p99, phase.p999, phase.max, phase.edits);
+
+        std::lock_guard<std::mutex> guard(resultLock);
+        results.push_back(phase);
+    }
+
+    running = false;
+}
+
+GatheringStressPhase GatheringStress::RunPhase(GatheringStressSettings const& settings, uint32 threads)
+{
+    // Loot mix: every known item plus as many ids the module does not handle,
+    // since OnLootItem also sees all the non-gathering loot
+    std::vector<uint32> itemIds;
+    std::vector<uint32> editIds;
+    std::vector<uint32> zoneIds{ 0 };
+    {
+        auto data = sGatheringExperience->GetSnapshot();
+        for (auto const& [itemId, item] : data->items)
+        {
+            itemIds.push_back(itemId);
+            itemIds.push_back(itemId + 1000000);
+            editIds.push_back(itemId);
+        }
+        for (auto const& [zoneId, multiplier] : data->zoneMultipliers)
+            zoneIds.push_back(zoneId);
+    }
+    if (itemIds.empty())
+        itemIds.push_back(1);
+
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    std::atomic<uint64> xpSink{0};
+    std::vector<GatheringLatencyHistogram> histograms(threads);
+    std::vector<std::thread> workers;
+
+    for (uint32 t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            std::mt19937 rng(t + 1);
+            uint32 playerCount = std::max(settings.playersPerThread, 1u);
+            std::vector<MockPlayer> players(playerCount);
+            for (uint32 i = 0; i < playerCount; ++i)
+            {
+                MockPlayer& player = players[i];
+                player.guid = ObjectGuid::Create<HighGuid::Player>(MOCK_GUID_BASE + t * playerCount + i);
+                player.state.level = rng() % GATHERING_MAX_LEVEL + 1;
+                for (uint32& skill : player.state.skills)
+                    skill = rng() % 451;
+                player.state.zoneId = zoneIds[rng() % zoneIds.size()];
+                player.x = static_cast<float>(rng() % 20000) - 10000.0f;
+                player.y = static_cast<float>(rng() % 20000) - 10000.0f;
+            }
+
+            // Next gather of each mock player, earliest first
+            using Due = std::pair<Clock::time_point, uint32>;
+            std::priority_queue<Due, std::vector<Due>, std::greater<Due>> schedule;
+
+            GatheringLatencyHistogram& histogram = histograms[t];
+            ObjectGuid::LowType lootCounter = 0;
+            uint64 xp = 0;
+
+            while (!go)
+                std::this_thread::yield();
+
+            Clock::time_point now = Clock::now();
+            if (settings.gatherInterval)
+                for (uint32 i = 0; i < playerCount; ++i)
+                    schedule.emplace(now + NextInterval(rng, settings.gatherInterval), i);
+
+            for (uint32 i = 0; i < settings.eventsPerThread && !stopping; ++i)
+            {
+                uint32 index;
+                if (settings.gatherInterval)
+                {
+                    Clock::time_point due = schedule.top().first;
+                    index = schedule.top().second;
+                    schedule.pop();
+                    schedule.emplace(due + NextInterval(rng, settings.gatherInterval), index);
+
+                    // In slices, so a shutdown does not wait out a long interval
+                    while (due > now && !stopping)
+                    {
+                        std::this_thread::sleep_until(std::min(due, now + std::chrono::milliseconds(100)));
+                        now = Clock::now();
+                    }
+                }
+                else
+                    index = rng() % playerCount;
+
+                // Every gather is a new node or corpse
+                uint32 itemId = itemIds[rng() % itemIds.size()];
+                xp += SimulateLoot(players[index], itemId, ObjectGuid::Create<HighGuid::GameObject>(0, ++lootCounter));
+
+                // The read ending one event starts the next, so the latency
+                // includes the picking above but the clock is read once
+                Clock::time_point end = Clock::now();
+                histogram.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - now).count());
+                now = end;
+            }
+
+            xpSink += xp;
+        });
+    }
+
+    // Edits as the item commands apply them: the row is re-read and a new
+    // snapshot published while the workers loot. Nothing is written or
+    // logged, so the data and the other worldservers are left alone.
+    uint32 edits = 0;
+    std::thread editor;
+    if (settings.editInterval && !editIds.empty())
+    {
+        editor = std::thread([&]()
+        {
+            std::mt19937 rng(0);
+            while (!stop && !stopping)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(settings.editInterval));
+
+                uint32 itemId = editIds[rng() % editIds.size()];
+                sGatheringExperience->ApplyChanges({ itemId }, {}, false);
+                ++edits;
+            }
+        });
+    }
+
+    auto begin = Clock::now();
+    go = true;
+    for (std::thread& worker : workers)
+        worker.join();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+
+    stop = true;
+    if (editor.joinable())
+        editor.join();
+
+    GatheringLatencyHistogram histogram;
+    for (GatheringLatencyHistogram const& threadHistogram : histograms)
+        histogram.Merge(threadHistogram);
+
+    GatheringStressPhase phase;
+    phase.threads = threads;
+    phase.events = histogram.GetCount();
+    phase.elapsed = static_cast<uint32>(elapsed);
+    phase.edits = edits;
+    phase.eventsPerSecond = phase.events * 1000.0 / std::max<int64>(elapsed, 1);
+    phase.targetPerSecond = settings.gatherInterval ? 1000.0 * threads * std::max(settings.playersPerThread, 1u) / settings.gatherInterval : 0.0;
+    phase.p50 = histogram.GetPercentile(0.5);
+    phase.p99 = histogram.GetPercentile(0.99);
+    phase.p999 = histogram.GetPercentile(0.999);
+    phase.max = histogram.GetMax();
+    return phase;
+}
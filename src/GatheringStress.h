@@ -0,0 +1,102 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_STRESS_H
+#define MODULE_GATHERING_EXPERIENCE_STRESS_H
+
+#include "GatheringExperience.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct GatheringStressSettings
+{
+    uint32 maxThreads;
+    uint32 eventsPerThread;
+    uint32 playersPerThread;
+    uint32 gatherInterval; // Mean ms between two gathers of a mock player, 0 gathers back to back
+    uint32 editInterval;   // ms between item edits, 0 disables
+};
+
+struct GatheringStressPhase
+{
+    uint32 threads;
+    uint64 events;
+    uint32 elapsed;         // ms
+    uint32 edits;
+    double eventsPerSecond;
+    double targetPerSecond; // What the mock players are paced at, 0 if unpaced
+    uint32 p50;             // ns
+    uint32 p99;
+    uint32 p999;
+    uint32 max;
+};
+
+// Latencies in buckets a quarter of a power of two wide: fixed size for any
+// number of events, percentiles within 25%
+class GatheringLatencyHistogram
+{
+public:
+    void Add(uint64 ns);
+    void Merge(GatheringLatencyHistogram const& other);
+
+    uint64 GetCount() const { return count; }
+    uint32 GetMax() const { return max; }
+
+    // Upper edge of the bucket holding the fraction, capped at the maximum
+    uint32 GetPercentile(double fraction) const;
+
+private:
+    // Exact below 8 ns, then 4 buckets per power of two up to 2^32
+    static constexpr uint32 BUCKETS = 124;
+
+    static uint32 GetBucket(uint32 ns);
+    static uint32 GetUpperEdge(uint32 bucket);
+
+    std::array<uint64, BUCKETS> buckets{};
+    uint64 count{0};
+    uint32 max{0};
+};
+
+// Runs mock players through the loot path from several threads: the same
+// snapshot lookups and formula as OnLootItem, then GatheringScorer with a player
+// data slot of their own, so rates, cohorts, zone eligibility, the bot check
+// and the caps see the load. Their gathers are sandboxed and stop before the
+// shared recorders: metrics, heatmap, captures, notices, stats and
+// leaderboards never see them. Each mock player gathers at its own jittered
+// pace. Meanwhile another thread re-reads items and publishes snapshots the
+// way the commands do, without writing anything. Runs phases of 1, 2, 4 ...
+// threads in the background.
+//
+// It competes with the world for CPU, so it refuses to run unless
+// GatheringExperience.Stress.Enable is set.
+class GatheringStress
+{
+public:
+    static GatheringStress* instance();
+    ~GatheringStress();
+
+    void LoadConfig();
+    bool IsAllowed() const { return allowed; }
+
+    bool Start(GatheringStressSettings const& settings);
+    bool IsRunning() const { return running; }
+
+    // Ends a running test and waits for it, on shutdown before the database goes away
+    void Stop();
+    std::vector<GatheringStressPhase> GetResults() const;
+
+private:
+    void Run(GatheringStressSettings settings);
+    GatheringStressPhase RunPhase(GatheringStressSettings const& settings, uint32 threads);
+
+    bool allowed{false};
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+    mutable std::mutex resultLock;
+    std::vector<GatheringStressPhase> results;
+};
+
+#define sGatheringStress GatheringStress::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_STRESS_H
@@ -0,0 +1,153 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringSync.h"
+#include "GatheringMetrics.h"
+#include "Common.h"
+
+GatheringSync* GatheringSync::instance()
+{
+    static GatheringSync instance;
+    return &instance;
+}
+
+void GatheringSync::LoadConfig()
+{
+    enabled = sConfigMgr->GetOption<bool>("GatheringExperience.Sync.Enable", true);
+    interval = sConfigMgr->GetOption<uint32>("GatheringExperience.Sync.Interval", 5000);
+    window = sConfigMgr->GetOption<uint32>("GatheringExperience.Sync.Window", 100);
+    retention = sConfigMgr->GetOption<uint32>("GatheringExperience.Sync.Retention", 7);
+}
+
+void GatheringSync::LogChange(GatheringChangeType type, uint32 entityId)
+{
+    sGatheringMetrics->OnEdit(type);
+
+    // A single worldserver has nobody to tell
+    if (!enabled)
+        return;
+
+    // The change itself was written directly, so the row never shows up before it
+    WorldDatabase.Execute("INSERT INTO gathering_experience_changelog (change_type, entity_id) VALUES ({}, {})",
+        static_cast<uint32>(type), entityId);
+}
+
+void GatheringSync::Reset()
+{
+    // Rows of the window that commit only after this are still picked up
+    applied.clear();
+    version = 0;
+
+    QueryResult result = WorldDatabase.Query(
+        "SELECT version FROM gathering_experience_changelog "
+        "WHERE version + {} > (SELECT MAX(version) FROM gathering_experience_changelog)", window);
+    if (result)
+    {
+        do
+        {
+            uint64 rowVersion = result->Fetch()[0].Get<uint64>();
+            applied.insert(rowVersion);
+            version = std::max(version, rowVersion);
+        } while (result->NextRow());
+    }
+
+    timer = 0;
+}
+
+void GatheringSync::Prune()
+{
+    // The table must never be empty: after a MySQL restart an empty table
+    // would hand out versions below the ones servers already applied
+    WorldDatabase.Execute(
+        "DELETE FROM gathering_experience_changelog WHERE changed_at < NOW() - INTERVAL {} DAY "
+        "AND version < (SELECT latest FROM (SELECT MAX(version) AS latest FROM gathering_experience_changelog) AS newest)",
+        retention);
+}
+
+void GatheringSync::Update(uint32 diff)
+{
+    queryProcessor.ProcessReadyCallbacks();
+
+    if (!enabled)
+        return;
+
+    if (retention)
+    {
+        pruneTimer += diff;
+        if (pruneTimer >= HOUR * IN_MILLISECONDS)
+        {
+            pruneTimer = 0;
+            Prune();
+        }
+    }
+
+    if (polling)
+        return;
+
+    timer += diff;
+    if (timer < interval)
+        return;
+
+    timer = 0;
+    polling = true;
+    queryProcessor.AddCallback(WorldDatabase.AsyncQuery(Acore::StringFormat(
+        "SELECT version, change_type, entity_id FROM gathering_experience_changelog WHERE version > {} ORDER BY version", GetWindowStart()))
+        .WithCallback([this](QueryResult result)
+        {
+            polling = false;
+            ApplyChanges(result);
+        }));
+}
+
+void GatheringSync::ApplyChanges(QueryResult result)
+{
+    if (!result)
+        return;
+
+    std::set<uint32> items;
+    std::set<uint32> zones;
+    bool settings = false;
+    bool reload = false;
+    bool changed = false;
+    uint64 latest = version;
+    uint64 windowStart = GetWindowStart();
+
+    do
+    {
+        Field* fields = result->Fetch();
+        uint64 rowVersion = fields[0].Get<uint64>();
+
+        // Applied by an earlier poll or covered by a full load that finished
+        // while the query ran
+        if (rowVersion <= windowStart || !applied.insert(rowVersion).second)
+            continue;
+
+        changed = true;
+        latest = std::max(latest, rowVersion);
+        switch (fields[1].Get<uint8>())
+        {
+            case GATHERING_CHANGE_ITEM:    items.insert(fields[2].Get<uint32>()); break;
+            case GATHERING_CHANGE_ZONE:    zones.insert(fields[2].Get<uint32>()); break;
+            case GATHERING_CHANGE_SETTING: settings = true;                       break;
+            default:                       reload = true;                         break;
+        }
+    } while (result->NextRow());
+
+    if (!changed)
+        return;
+
+    if (reload)
+    {
+        LOG_INFO("module", "Gathering data changed on another worldserver, reloading");
+        sGatheringExperience->LoadDataFromDB();
+        return;
+    }
+
+    sGatheringExperience->ApplyChanges(items, zones, settings);
+    version = latest;
+    applied.erase(applied.begin(), applied.upper_bound(GetWindowStart()));
+
+    LOG_INFO("module", "Applied {} item, {} zone and {} setting changes up to gathering data version {}",
+        items.size(), zones.size(), settings ? 1 : 0, version);
+}
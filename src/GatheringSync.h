@@ -0,0 +1,64 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_SYNC_H
+#define MODULE_GATHERING_EXPERIENCE_SYNC_H
+
+#include "GatheringExperience.h"
+#include "DatabaseEnv.h"
+#include <set>
+
+enum GatheringChangeType
+{
+    GATHERING_CHANGE_RELOAD  = 0,
+    GATHERING_CHANGE_ITEM    = 1,
+    GATHERING_CHANGE_ZONE    = 2,
+    GATHERING_CHANGE_SETTING = 3
+};
+
+// Keeps worldservers sharing one world database in step. Every change is
+// appended to gathering_experience_changelog; each server polls for rows
+// newer than the last version it applied and reloads only those entries.
+// Versions are auto-increment values handed out before the insert commits,
+// so a lower one can become visible after a higher one: each poll re-reads
+// a window of versions below the latest and skips those already applied.
+class GatheringSync
+{
+public:
+    static GatheringSync* instance();
+
+    void LoadConfig();
+
+    // Records a change after it was written to the world database, nothing
+    // is logged while sync is disabled
+    void LogChange(GatheringChangeType type, uint32 entityId = 0);
+
+    // Marks everything logged so far as applied, called before a full load
+    void Reset();
+
+    // World thread only
+    void Update(uint32 diff);
+
+    uint64 GetVersion() const { return version; }
+
+private:
+    void ApplyChanges(QueryResult result);
+
+    // Deletes rows older than the retention, but never the latest one
+    void Prune();
+
+    // Lowest version a poll still reads
+    uint64 GetWindowStart() const { return version > window ? version - window : 0; }
+
+    bool enabled{true};
+    uint32 interval{5000};
+    uint32 window{100};
+    uint32 retention{7};      // Days, 0 keeps every row
+    uint32 timer{0};
+    uint32 pruneTimer{0};
+    bool polling{false};
+    uint64 version{0};
+    std::set<uint64> applied; // Versions inside the window
+    QueryCallbackProcessor queryProcessor;
+};
+
+#define sGatheringSync GatheringSync::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_SYNC_H
@@ -0,0 +1,156 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringTasks.h"
+#include "Config.h"
+#include "Log.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "Timer.h"
+
+namespace
+{
+    // Output of a task whose owner logged out
+    class GatheringLogHandler : public ChatHandler
+    {
+    public:
+        GatheringLogHandler() : ChatHandler(nullptr) { }
+
+        void SendSysMessage(std::string_view str, bool /*escapeCharacters*/) override
+        {
+            LOG_INFO("module", "Gathering task: {}", str);
+        }
+    };
+}
+
+bool GatheringQueryTask::Step(ChatHandler* handler)
+{
+    if (commit)
+    {
+        WorldDatabaseTransaction trans = std::move(commit);
+        commit = nullptr;
+
+        if (!handler->GetSession())
+            WorldDatabase.DirectCommitTransaction(trans);
+        else
+        {
+            committing = true;
+            commitProcessor.AddCallback(WorldDatabase.AsyncCommitTransaction(trans)).AfterComplete([this](bool /*success*/)
+            {
+                committing = false;
+            });
+        }
+    }
+
+    if (committing)
+    {
+        commitProcessor.ProcessReadyCallbacks();
+        if (committing)
+            return false;
+    }
+
+    if (!queried)
+    {
+        queried = true;
+
+        // The console waits for its rows, there is no later update to pick them up
+        if (!handler->GetSession())
+        {
+            result = WorldDatabase.Query(query);
+            received = true;
+        }
+        else
+        {
+            queryProcessor.AddCallback(WorldDatabase.AsyncQuery(query).WithCallback([this](QueryResult rows)
+            {
+                result = rows;
+                received = true;
+            }));
+        }
+    }
+
+    if (!received)
+    {
+        queryProcessor.ProcessReadyCallbacks();
+        if (!received)
+            return false;
+    }
+
+    if (!started)
+    {
+        started = true;
+        if (!result)
+        {
+            handler->SendSysMessage(emptyMessage);
+            return true;
+        }
+        handler->SendSysMessage(header);
+    }
+
+    for (uint32 rows = 0; rows < ROWS_PER_STEP; ++rows)
+    {
+        printer(handler, result->Fetch());
+        if (!result->NextRow())
+            return true;
+    }
+
+    return false;
+}
+
+GatheringTaskQueue* GatheringTaskQueue::instance()
+{
+    static GatheringTaskQueue instance;
+    return &instance;
+}
+
+void GatheringTaskQueue::LoadConfig()
+{
+    budget = std::max<uint32>(1, sConfigMgr->GetOption<uint32>("GatheringExperience.Commands.TickBudget", 5));
+}
+
+void GatheringTaskQueue::Start(ChatHandler* handler, std::unique_ptr<GatheringTask> task)
+{
+    WorldSession* session = handler->GetSession();
+    if (!session || !session->GetPlayer())
+    {
+        while (!task->Step(handler));
+        return;
+    }
+
+    // The first chunk runs right away so short commands answer in the same tick
+    if (!task->Step(handler))
+        tasks.push_back({ session->GetPlayer()->GetGUID(), std::move(task) });
+}
+
+void GatheringTaskQueue::Update()
+{
+    if (tasks.empty())
+        return;
+
+    uint32 start = getMSTime();
+
+    // Round robin, one step per task per update until the budget is spent
+    for (std::size_t count = tasks.size(); count && getMSTimeDiff(start, getMSTime()) < budget; --count)
+    {
+        Entry entry = std::move(tasks.front());
+        tasks.pop_front();
+
+        bool done;
+        if (Player* player = ObjectAccessor::FindConnectedPlayer(entry.owner))
+        {
+            ChatHandler handler(player->GetSession());
+            done = entry.task->Step(&handler);
+        }
+        else if (entry.task->IsDroppable())
+            continue;
+        else
+        {
+            GatheringLogHandler handler;
+            done = entry.task->Step(&handler);
+        }
+
+        if (!done)
+            tasks.push_back(std::move(entry));
+    }
+}
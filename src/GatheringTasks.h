@@ -0,0 +1,89 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_TASKS_H
+#define MODULE_GATHERING_EXPERIENCE_TASKS_H
+
+#include "Chat.h"
+#include "DatabaseEnv.h"
+#include <deque>
+#include <functional>
+#include <memory>
+
+// Command work that can be resumed. Step does one bounded chunk, sending any
+// output to the handler, and returns true once there is nothing left to do.
+class GatheringTask
+{
+public:
+    virtual ~GatheringTask() = default;
+
+    virtual bool Step(ChatHandler* handler) = 0;
+
+    // Tasks that only show something stop when their owner logs out; tasks
+    // that write something run to the end with their output in the log
+    virtual bool IsDroppable() const { return true; }
+};
+
+// Streams the rows of a world database query to the handler. The query runs
+// asynchronously for players and a fixed number of rows is printed per step.
+class GatheringQueryTask : public GatheringTask
+{
+public:
+    typedef std::function<void(ChatHandler*, Field*)> RowPrinter;
+
+    static const uint32 ROWS_PER_STEP = 25;
+
+    GatheringQueryTask(std::string query, std::string header, std::string emptyMessage, RowPrinter printer)
+        : query(std::move(query)), header(std::move(header)), emptyMessage(std::move(emptyMessage)), printer(std::move(printer)) { }
+
+    // Commits trans before querying, so the rows include what it writes
+    void CommitFirst(WorldDatabaseTransaction trans) { commit = std::move(trans); }
+
+    bool Step(ChatHandler* handler) override;
+
+private:
+    std::string query;
+    std::string header;
+    std::string emptyMessage;
+    RowPrinter printer;
+
+    WorldDatabaseTransaction commit;
+    AsyncCallbackProcessor<TransactionCallback> commitProcessor;
+    bool committing{false};
+
+    QueryCallbackProcessor queryProcessor;
+    QueryResult result;
+    bool queried{false};
+    bool received{false};
+    bool started{false};
+};
+
+// Runs command tasks a step at a time from the world update so no single
+// command holds up a tick. Output goes to the player who started the task,
+// or to the server log once they logged out; the console has no session to
+// resume on, so its tasks finish immediately.
+class GatheringTaskQueue
+{
+public:
+    static GatheringTaskQueue* instance();
+
+    void LoadConfig();
+
+    void Start(ChatHandler* handler, std::unique_ptr<GatheringTask> task);
+
+    // World thread only
+    void Update();
+
+    std::size_t GetPending() const { return tasks.size(); }
+
+private:
+    struct Entry
+    {
+        ObjectGuid owner;
+        std::unique_ptr<GatheringTask> task;
+    };
+
+    std::deque<Entry> tasks;
+    uint32 budget{5}; // Milliseconds of task work per world update
+};
+
+#define sGatheringTasks GatheringTaskQueue::instance()
+
+#endif //MODULE_GATHERING_EXPERIENCE_TASKS_H
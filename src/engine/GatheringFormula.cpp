@@ -0,0 +1,126 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringFormula.h"
+#include <cstdlib>
+
+float GatheringFormula::GetLevelPenalty(uint32 playerLevel, uint32 recommendedLevel)
+{
+    int32 levelDiff = static_cast<int32>(playerLevel) - static_cast<int32>(recommendedLevel);
+
+    if (levelDiff < 0)  // Player is below recommended level
+        return std::max(MIN_UNDERLEVEL_PENALTY, 1.0f - (std::abs(levelDiff) * LEVEL_PENALTY_RATE));
+
+    if (levelDiff > 0)  // Player is above recommended level
+        return std::max(MIN_OVERLEVEL_PENALTY, 1.0f - (levelDiff * LEVEL_PENALTY_RATE));
+
+    return 1.0f;
+}
+
+uint32 GatheringFormula::GetDefaultRecommendedLevel(uint32 baseXP)
+{
+    if (baseXP >= 800)      return 80;  // Northrend
+    if (baseXP >= 700)      return 70;  // Northrend
+    if (baseXP >= 600)      return 60;  // Outland
+    if (baseXP >= 500)      return 50;  // High vanilla
+    if (baseXP >= 400)      return 40;  // Mid-high vanilla
+    if (baseXP >= 300)      return 30;  // Mid vanilla
+    if (baseXP >= 200)      return 20;  // Low vanilla
+    return 10;                          // Beginner
+}
+
+uint8 GatheringFormula::GetRarityLabel(float multiplier)
+{
+    if (multiplier >= 1.5f)
+        return 2; // Rare
+    if (multiplier > 1.0f)
+        return 1; // Uncommon
+    return 0;
+}
+
+float GatheringFormula::GetNodeColorFactor(uint32 skill, uint32 gray, uint32 green, uint32 yellow)
+{
+    if (skill >= gray)
+        return NODE_GRAY_FACTOR;
+    if (skill >= green)
+        return NODE_GREEN_FACTOR;
+    if (skill >= yellow)
+        return NODE_YELLOW_FACTOR;
+    return NODE_ORANGE_FACTOR;
+}
+
+float GatheringFormula::GetZoneMultiplier(GatheringSnapshot const& data, uint32 zoneId)
+{
+    auto it = data.zoneMultipliers.find(zoneId);
+    if (it != data.zoneMultipliers.end())
+        return it->second;
+    return 1.0f; // Default multiplier if zone not found
+}
+
+GatheringXPResult GatheringFormula::ComputeGathering(GatheringItem const& item, GatheringXPInput const& input)
+{
+    GatheringXPResult result;
+    result.adjustedBaseXP = item.baseXP;
+
+    // Reduce XP when the player is far from the item's recommended level
+    result.levelPenalty = GetLevelPenalty(input.level, item.recommendedLevel);
+
+    // Calculate progress bonus (0-30% based on skill)
+    result.progressBonus = std::min(0.3f, input.skill / 450.0f);
+
+    result.zoneMultiplier = 1.0f;
+    result.rarityMultiplier = item.rarityMultiplier;
+
+    result.normalXP = static_cast<uint32>(item.baseXP * result.levelPenalty * (1.0f + result.progressBonus) * result.rarityMultiplier);
+    result.finalXP = std::min(result.normalXP, MAX_EXPERIENCE_GAIN);
+    return result;
+}
+
+GatheringXPResult GatheringFormula::ComputeFishing(GatheringItem const& item, GatheringXPInput const& input)
+{
+    GatheringXPResult result;
+
+    // Adjust base XP based on skill tiers
+    result.adjustedBaseXP = item.baseXP;
+    if (input.skill > 300)
+        result.adjustedBaseXP = std::max(result.adjustedBaseXP, 200u);
+    else if (input.skill > 150)
+        result.adjustedBaseXP = std::max(result.adjustedBaseXP, 125u);
+    else if (input.skill > 75)
+        result.adjustedBaseXP = std::max(result.adjustedBaseXP, 100u);
+
+    // Recommended level is resolved once at load time
+    result.levelPenalty = GetLevelPenalty(input.level, item.recommendedLevel);
+
+    // Calculate progress bonus (0-30% based on skill)
+    result.progressBonus = std::min(0.3f, input.skill / 450.0f);
+
+    result.zoneMultiplier = input.zoneMultiplier;
+    result.rarityMultiplier = item.rarityMultiplier;
+
+    result.normalXP = static_cast<uint32>(result.adjustedBaseXP * result.levelPenalty * (1.0f + result.progressBonus) * result.zoneMultiplier * result.rarityMultiplier);
+    result.finalXP = std::min(result.normalXP, MAX_EXPERIENCE_GAIN);
+    return result;
+}
+
+GatheringXPResult GatheringFormula::Compute(GatheringItem const& item, GatheringXPInput const& input)
+{
+    switch (item.profession)
+    {
+        case PROF_MINING:
+        case PROF_HERBALISM:
+        case PROF_SKINNING:  return ComputeGathering(item, input);
+        case PROF_FISHING:   return ComputeFishing(item, input);
+        default:             return GatheringXPResult{};
+    }
+}
+
+GatheringXPInput GatheringFormula::MakeInput(GatheringSnapshot const& data, GatheringItem const& item, GatheringPlayerState const& player)
+{
+    GatheringXPInput input;
+    input.level = player.level;
+    input.skill = item.profession >= PROF_MINING && item.profession <= PROF_FISHING ? player.skills[item.profession - 1] : 0;
+    input.zoneMultiplier = item.profession == PROF_FISHING ? GetZoneMultiplier(data, player.zoneId) : 1.0f; // Zone multipliers only apply to fishing
+    return input;
+}
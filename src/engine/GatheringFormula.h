@@ -0,0 +1,84 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_FORMULA_H
+#define MODULE_GATHERING_EXPERIENCE_FORMULA_H
+
+#include "GatheringSnapshot.h"
+
+// Constants
+const uint32 GATHERING_MAX_LEVEL = 80;
+const uint32 MAX_EXPERIENCE_GAIN = 5000;
+const uint32 MIN_EXPERIENCE_GAIN = 10;
+
+enum GatheringProfessions
+{
+    PROF_MINING     = 1,
+    PROF_HERBALISM  = 2,
+    PROF_SKINNING   = 3,
+    PROF_FISHING    = 4
+};
+
+// Player independent inputs of an XP calculation
+struct GatheringXPInput
+{
+    uint32 level;
+    uint32 skill;
+    float zoneMultiplier;
+};
+
+// Outcome of an XP calculation with the factors that went into it
+struct GatheringXPResult
+{
+    uint32 adjustedBaseXP;
+    float levelPenalty;
+    float progressBonus;
+    float zoneMultiplier;
+    float rarityMultiplier;
+    uint32 normalXP;
+    uint32 finalXP;
+};
+
+// What a gathering character brings to the formulas
+struct GatheringPlayerState
+{
+    uint32 level;
+    std::array<uint32, 4> skills; // Per profession (id - 1)
+    uint32 zoneId;
+};
+
+// The XP formulas. They only read their arguments and a snapshot, and use
+// nothing from the server, so this directory builds and runs on its own
+// (with any Define.h providing the fixed width integer types).
+namespace GatheringFormula
+{
+    // Level difference penalty
+    constexpr float LEVEL_PENALTY_RATE = 0.03f;
+    constexpr float MIN_UNDERLEVEL_PENALTY = 0.01f;
+    constexpr float MIN_OVERLEVEL_PENALTY = 0.4f;
+
+    // Node-level XP by node color for the player's skill
+    constexpr float NODE_ORANGE_FACTOR = 1.2f;
+    constexpr float NODE_YELLOW_FACTOR = 1.0f;
+    constexpr float NODE_GREEN_FACTOR = 0.5f;
+    constexpr float NODE_GRAY_FACTOR = 0.1f;
+
+    float GetLevelPenalty(uint32 playerLevel, uint32 recommendedLevel);
+    uint32 GetDefaultRecommendedLevel(uint32 baseXP);
+
+    // Label of a rarity multiplier for messages: Rare from 1.5, Uncommon
+    // above 1, otherwise common. XP uses the multiplier itself.
+    uint8 GetRarityLabel(float multiplier);
+    float GetNodeColorFactor(uint32 skill, uint32 gray, uint32 green, uint32 yellow);
+    float GetZoneMultiplier(GatheringSnapshot const& data, uint32 zoneId);
+
+    // Mining, herbalism and skinning share one formula; fishing adds skill
+    // tiers and zone multipliers
+    GatheringXPResult ComputeGathering(GatheringItem const& item, GatheringXPInput const& input);
+    GatheringXPResult ComputeFishing(GatheringItem const& item, GatheringXPInput const& input);
+
+    // Formula of the item's profession, all zero for an unknown profession
+    GatheringXPResult Compute(GatheringItem const& item, GatheringXPInput const& input);
+
+    // Input for an item from a character's state; the zone only counts for fishing
+    GatheringXPInput MakeInput(GatheringSnapshot const& data, GatheringItem const& item, GatheringPlayerState const& player);
+}
+
+#endif //MODULE_GATHERING_EXPERIENCE_FORMULA_H
@@ -0,0 +1,208 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringGoldenTable.h"
+#include "GatheringFormula.h"
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
+namespace
+{
+    const char* GOLDEN_HEADER = "# Gathering Experience golden XP v2";
+
+    GatheringGolden::Row const* FindRow(std::vector<GatheringGolden::Row> const& rows, GatheringGolden::Row const& key)
+    {
+        for (GatheringGolden::Row const& row : rows)
+            if (row.level == key.level && row.zoneMultiplier == key.zoneMultiplier)
+                return &row;
+        return nullptr;
+    }
+
+    // "1.5:" style zone of a row, the colon ends the key
+    bool ParseZone(std::string const& text, float& zoneMultiplier)
+    {
+        char* end;
+        zoneMultiplier = std::strtof(text.c_str(), &end);
+        return end != text.c_str() && end[0] == ':' && end[1] == '\0';
+    }
+}
+
+std::vector<float> GatheringGolden::GetZoneMultipliers(GatheringSnapshot const& data)
+{
+    std::set<float> multipliers = { 1.0f };
+    for (auto const& [zoneId, multiplier] : data.zoneMultipliers)
+        multipliers.insert(multiplier);
+    return std::vector<float>(multipliers.begin(), multipliers.end());
+}
+
+void GatheringGolden::Evaluate(uint32 itemId, GatheringItem const& item, std::vector<float> const& zoneMultipliers, std::vector<Row>& rows)
+{
+    static const std::vector<float> unzoned = { 1.0f };
+    std::vector<float> const& zones = item.profession == PROF_FISHING ? zoneMultipliers : unzoned;
+
+    for (uint32 level : LEVELS)
+    {
+        for (float zoneMultiplier : zones)
+        {
+            Row& row = rows.emplace_back();
+            row.itemId = itemId;
+            row.level = level;
+            row.zoneMultiplier = zoneMultiplier;
+            for (std::size_t i = 0; i < SKILLS.size(); ++i)
+                row.xp[i] = GatheringFormula::Compute(item, { level, SKILLS[i], zoneMultiplier }).finalXP;
+        }
+    }
+}
+
+std::string GatheringGolden::FormatZone(float zoneMultiplier)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", zoneMultiplier);
+    return text;
+}
+
+std::string GatheringGolden::FormatHeader(std::vector<float> const& zoneMultipliers)
+{
+    std::string header = std::string(GOLDEN_HEADER) + "\n# item level zone_multiplier: XP at each skill\nskills";
+    for (uint32 skill : SKILLS)
+        header += ' ' + std::to_string(skill);
+    header += "\nzones";
+    for (float multiplier : zoneMultipliers)
+        header += ' ' + FormatZone(multiplier);
+    return header + '\n';
+}
+
+std::string GatheringGolden::FormatRow(Row const& row)
+{
+    std::string line = std::to_string(row.itemId) + ' ' + std::to_string(row.level) + ' ' + FormatZone(row.zoneMultiplier) + ':';
+    for (uint32 xp : row.xp)
+        line += ' ' + std::to_string(xp);
+    return line + '\n';
+}
+
+std::string GatheringGolden::Format(GatheringSnapshot const& data)
+{
+    std::vector<float> zoneMultipliers = GetZoneMultipliers(data);
+    std::string text = FormatHeader(zoneMultipliers);
+
+    std::vector<Row> rows;
+    for (auto [itemId, item] : data.items)
+    {
+        rows.clear();
+        Evaluate(itemId, item, zoneMultipliers, rows);
+        for (Row const& row : rows)
+            text += FormatRow(row);
+    }
+    return text;
+}
+
+bool GatheringGolden::Checker::Load(std::istream& in, std::string& error)
+{
+    std::string line;
+    if (!std::getline(in, line) || line != GOLDEN_HEADER)
+    {
+        error = "not a golden XP table";
+        return false;
+    }
+
+    bool hasZones = false;
+    for (uint32 lineNumber = 2; std::getline(in, line); ++lineNumber)
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+
+        if (key == "skills")
+        {
+            std::vector<uint32> skills;
+            for (uint32 skill; fields >> skill; )
+                skills.push_back(skill);
+            if (!std::equal(skills.begin(), skills.end(), SKILLS.begin(), SKILLS.end()))
+            {
+                error = "recorded at other skills, write it again";
+                return false;
+            }
+            continue;
+        }
+
+        if (key == "zones")
+        {
+            for (float multiplier; fields >> multiplier; )
+                zoneMultipliers.push_back(multiplier);
+            hasZones = true;
+            continue;
+        }
+
+        Row row;
+        std::string zone;
+        char* end;
+        row.itemId = static_cast<uint32>(std::strtoul(key.c_str(), &end, 10));
+        bool valid = hasZones && *end == '\0' && fields >> row.level >> zone && ParseZone(zone, row.zoneMultiplier);
+        for (std::size_t i = 0; valid && i < SKILLS.size(); ++i)
+            valid = static_cast<bool>(fields >> row.xp[i]);
+
+        if (!valid)
+        {
+            error = "malformed line " + std::to_string(lineNumber);
+            return false;
+        }
+
+        expected[row.itemId].push_back(row);
+    }
+
+    return true;
+}
+
+void GatheringGolden::Checker::Check(uint32 itemId, GatheringItem const& item)
+{
+    auto itr = expected.find(itemId);
+    if (itr == expected.end())
+    {
+        report.added.push_back(itemId);
+        return;
+    }
+
+    ++report.checked;
+    uint32 differing = report.differing;
+
+    rows.clear();
+    Evaluate(itemId, item, zoneMultipliers, rows);
+    for (Row const& row : rows)
+    {
+        Row const* old = FindRow(itr->second, row);
+        for (std::size_t i = 0; i < SKILLS.size(); ++i)
+            if (!old || old->xp[i] != row.xp[i])
+                Record(row, i, old ? std::optional<uint32>(old->xp[i]) : std::nullopt, row.xp[i]);
+    }
+
+    // Rows only the table has, e.g. zones of an item that no longer fishes
+    for (Row const& old : itr->second)
+        if (!FindRow(rows, old))
+            for (std::size_t i = 0; i < SKILLS.size(); ++i)
+                Record(old, i, old.xp[i], std::nullopt);
+
+    if (report.differing != differing)
+        report.changed.push_back(itemId);
+    expected.erase(itr);
+}
+
+void GatheringGolden::Checker::Record(Row const& row, std::size_t skill, std::optional<uint32> expectedXP, std::optional<uint32> actualXP)
+{
+    ++report.differing;
+    if (report.differences.size() < Report::MAX_DIFFERENCES)
+        report.differences.push_back({ row.itemId, row.level, SKILLS[skill], row.zoneMultiplier, expectedXP, actualXP });
+}
+
+GatheringGolden::Report const& GatheringGolden::Checker::Finish()
+{
+    for (auto const& [itemId, rows] : expected)
+        report.removed.push_back(itemId);
+    expected.clear();
+    return report;
+}
@@ -0,0 +1,92 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_GOLDEN_TABLE_H
+#define MODULE_GATHERING_EXPERIENCE_GOLDEN_TABLE_H
+
+#include "GatheringSnapshot.h"
+#include <istream>
+#include <optional>
+
+// Golden XP tables: the XP of items over a grid of levels, skills and zone
+// multipliers, stored as readable rows. A row is one item at one level and
+// zone multiplier with the XP at every skill of the grid:
+//   2770 10 1: 100 110 116 116 120 130 130 130 130 130 130
+// Checking a table names the first (item, level, skill, zone) tuples whose
+// XP moved.
+namespace GatheringGolden
+{
+    // Each tier edge of the formulas (fishing skill tiers, the progress
+    // bonus cap) and an even spread in between
+    constexpr std::array<uint32, 9> LEVELS = { 1, 10, 20, 30, 40, 50, 60, 70, 80 };
+    constexpr std::array<uint32, 11> SKILLS = { 0, 45, 75, 76, 90, 135, 150, 151, 300, 301, 450 };
+
+    struct Row
+    {
+        uint32 itemId;
+        uint32 level;
+        float zoneMultiplier;
+        std::array<uint32, SKILLS.size()> xp;
+    };
+
+    // A tuple whose XP changed; a side is empty when its row is missing
+    struct Difference
+    {
+        uint32 itemId;
+        uint32 level;
+        uint32 skill;
+        float zoneMultiplier;
+        std::optional<uint32> expected;
+        std::optional<uint32> actual;
+    };
+
+    struct Report
+    {
+        static constexpr std::size_t MAX_DIFFERENCES = 20;
+
+        uint32 checked{0};
+        uint32 differing{0};                  // Tuples
+        std::vector<uint32> changed;
+        std::vector<uint32> added;            // Scored but not in the golden table
+        std::vector<uint32> removed;          // In the golden table but not scored
+        std::vector<Difference> differences;  // The first MAX_DIFFERENCES
+
+        bool Passed() const { return changed.empty() && added.empty() && removed.empty(); }
+    };
+
+    // Zone multipliers fishing is scored at, 1 and every configured one.
+    // The other professions ignore the zone and are scored at 1 only.
+    std::vector<float> GetZoneMultipliers(GatheringSnapshot const& data);
+
+    // Appends the rows of an item, by level and then zone multiplier
+    void Evaluate(uint32 itemId, GatheringItem const& item, std::vector<float> const& zoneMultipliers, std::vector<Row>& rows);
+
+    // Comment, grid and zone lines that start a table
+    std::string FormatHeader(std::vector<float> const& zoneMultipliers);
+    std::string FormatRow(Row const& row);
+    std::string FormatZone(float zoneMultiplier);
+
+    // Whole table of a snapshot, items in id order
+    std::string Format(GatheringSnapshot const& data);
+
+    // Compares items against a stored table, one item at a time
+    class Checker
+    {
+    public:
+        // False with a message when the text is not a golden table of this grid
+        bool Load(std::istream& in, std::string& error);
+
+        void Check(uint32 itemId, GatheringItem const& item);
+
+        // Items of the table never checked count as removed
+        Report const& Finish();
+
+    private:
+        void Record(Row const& row, std::size_t skill, std::optional<uint32> expectedXP, std::optional<uint32> actualXP);
+
+        // Scored at the table's zone multipliers, not the current ones
+        std::vector<float> zoneMultipliers;
+        std::map<uint32, std::vector<Row>> expected;
+        std::vector<Row> rows;
+        Report report;
+    };
+}
+
+#endif //MODULE_GATHERING_EXPERIENCE_GOLDEN_TABLE_H
@@ -0,0 +1,353 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringSeed.h"
+#include "GatheringFormula.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    struct SqlValue
+    {
+        std::string text;
+        bool isNull{false};
+    };
+
+    // Cursor over SQL text, skipping whitespace and comments between tokens
+    class SqlReader
+    {
+    public:
+        explicit SqlReader(std::string_view sql) : sql(sql) { }
+
+        bool AtEnd() { SkipBlank(); return pos >= sql.size(); }
+        bool Consume(char c)
+        {
+            SkipBlank();
+            if (pos >= sql.size() || sql[pos] != c)
+                return false;
+            ++pos;
+            return true;
+        }
+
+        // Keyword or identifier without backticks, empty if none is next
+        std::string ReadWord()
+        {
+            SkipBlank();
+            std::size_t start = pos;
+            if (pos < sql.size() && sql[pos] == '`')
+            {
+                std::size_t end = sql.find('`', pos + 1);
+                if (end == std::string_view::npos)
+                    return "";
+                pos = end + 1;
+                return std::string(sql.substr(start + 1, end - start - 1));
+            }
+
+            while (pos < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[pos])) || sql[pos] == '_'))
+                ++pos;
+            return std::string(sql.substr(start, pos - start));
+        }
+
+        // A quoted string, NULL or number
+        bool ReadValue(SqlValue& value)
+        {
+            SkipBlank();
+            value.text.clear();
+            value.isNull = false;
+            if (pos >= sql.size())
+                return false;
+
+            char quote = sql[pos];
+            if (quote == '\'' || quote == '"')
+            {
+                for (++pos; pos < sql.size(); ++pos)
+                {
+                    char c = sql[pos];
+                    if (c == '\\' && pos + 1 < sql.size())
+                        value.text += sql[++pos];
+                    else if (c != quote)
+                        value.text += c;
+                    else if (pos + 1 < sql.size() && sql[pos + 1] == quote)
+                        value.text += sql[++pos];
+                    else
+                    {
+                        ++pos;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::size_t start = pos;
+            while (pos < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[pos])) || sql[pos] == '.' || sql[pos] == '-' || sql[pos] == '+'))
+                ++pos;
+            value.text = sql.substr(start, pos - start);
+            for (char& c : value.text)
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            value.isNull = value.text == "NULL";
+            return !value.text.empty();
+        }
+
+        // Moves past the next ';' outside quotes and comments
+        void SkipStatement()
+        {
+            char quote = '\0';
+            for (; pos < sql.size(); ++pos)
+            {
+                char c = sql[pos];
+                if (!quote && (c == '#' || sql.compare(pos, 2, "--") == 0 || sql.compare(pos, 2, "/*") == 0))
+                {
+                    SkipBlank();
+                    --pos;
+                }
+                else if (quote)
+                {
+                    if (c == '\\')
+                        ++pos;
+                    else if (c == quote)
+                        quote = '\0';
+                }
+                else if (c == '\'' || c == '"' || c == '`')
+                    quote = c;
+                else if (c == ';')
+                {
+                    ++pos;
+                    return;
+                }
+            }
+        }
+
+        uint32 GetLine() const
+        {
+            return 1 + static_cast<uint32>(std::count(sql.begin(), sql.begin() + std::min(pos, sql.size()), '\n'));
+        }
+
+    private:
+        void SkipBlank()
+        {
+            while (pos < sql.size())
+            {
+                if (std::isspace(static_cast<unsigned char>(sql[pos])))
+                    ++pos;
+                else if (sql.compare(pos, 2, "--") == 0 || sql[pos] == '#')
+                {
+                    std::size_t end = sql.find('\n', pos);
+                    pos = end == std::string_view::npos ? sql.size() : end + 1;
+                }
+                else if (sql.compare(pos, 2, "/*") == 0)
+                {
+                    std::size_t end = sql.find("*/", pos + 2);
+                    pos = end == std::string_view::npos ? sql.size() : end + 2;
+                }
+                else
+                    break;
+            }
+        }
+
+        std::string_view sql;
+        std::size_t pos{0};
+    };
+
+    std::string Upper(std::string word)
+    {
+        for (char& c : word)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return word;
+    }
+
+    // One row of a known table, values looked up by column name
+    class SqlRow
+    {
+    public:
+        SqlRow(std::vector<std::string> const& columns, std::vector<SqlValue> const& values) : columns(columns), values(values) { }
+
+        SqlValue const* Get(std::string_view column) const
+        {
+            for (std::size_t i = 0; i < columns.size() && i < values.size(); ++i)
+                if (columns[i] == column)
+                    return &values[i];
+            return nullptr;
+        }
+
+        bool GetUInt(std::string_view column, uint32& value) const
+        {
+            SqlValue const* field = Get(column);
+            if (!field || field->isNull)
+                return false;
+
+            char* end;
+            unsigned long parsed = std::strtoul(field->text.c_str(), &end, 10);
+            value = static_cast<uint32>(std::min<unsigned long>(parsed, UINT32_MAX));
+            return *end == '\0';
+        }
+
+        bool GetFloat(std::string_view column, float& value) const
+        {
+            SqlValue const* field = Get(column);
+            if (!field || field->isNull)
+                return false;
+
+            char* end;
+            value = std::strtof(field->text.c_str(), &end);
+            return *end == '\0';
+        }
+
+    private:
+        std::vector<std::string> const& columns;
+        std::vector<SqlValue> const& values;
+    };
+
+    // Adds a row of one of the module's tables, false if a needed column is missing or not a number
+    bool AddRow(std::string const& table, SqlRow const& row, GatheringSnapshot& data)
+    {
+        if (table == "gathering_experience")
+        {
+            uint32 itemId, baseXP, requiredSkill, profession;
+            if (!row.GetUInt("item_id", itemId) || !row.GetUInt("base_xp", baseXP) ||
+                !row.GetUInt("required_skill", requiredSkill) || !row.GetUInt("profession", profession))
+                return false;
+
+            if (data.items.Find(itemId))
+                return true;
+
+            // Same conversions as the database loader
+            GatheringItem item;
+            item.baseXP = static_cast<uint16>(std::min<uint32>(baseXP, UINT16_MAX));
+            item.requiredSkill = static_cast<uint16>(std::min<uint32>(requiredSkill, UINT16_MAX));
+            item.profession = static_cast<uint8>(profession);
+            item.rarity = 0;
+
+            uint32 recommendedLevel;
+            item.recommendedLevel = row.GetUInt("recommended_level", recommendedLevel)
+                ? static_cast<uint8>(recommendedLevel)
+                : GatheringFormula::GetDefaultRecommendedLevel(baseXP);
+
+            SqlValue const* name = row.Get("name");
+            data.items.Set(itemId, item, name ? name->text : "");
+            return true;
+        }
+
+        if (table == "gathering_experience_zones" || table == "gathering_experience_rarity")
+        {
+            char const* key = table == "gathering_experience_zones" ? "zone_id" : "item_id";
+            uint32 id;
+            float multiplier;
+            if (!row.GetUInt(key, id) || !row.GetFloat("multiplier", multiplier))
+                return false;
+
+            (table == "gathering_experience_zones" ? data.zoneMultipliers : data.rarityMultipliers).emplace(id, multiplier);
+            return true;
+        }
+
+        if (table == "gathering_experience_item_zones")
+        {
+            uint32 itemId, zoneId;
+            if (!row.GetUInt("item_id", itemId) || !row.GetUInt("zone_id", zoneId))
+                return false;
+
+            data.itemZones.emplace_back(itemId, zoneId);
+            return true;
+        }
+
+        return true;
+    }
+}
+
+bool GatheringSeed::Parse(std::string_view sql, GatheringSnapshot& data, std::string& error)
+{
+    SqlReader reader(sql);
+    std::vector<std::string> columns;
+    std::vector<SqlValue> values;
+
+    auto fail = [&](char const* what)
+    {
+        error = std::string(what) + " at line " + std::to_string(reader.GetLine());
+        return false;
+    };
+
+    while (!reader.AtEnd())
+    {
+        if (Upper(reader.ReadWord()) != "INSERT")
+        {
+            reader.SkipStatement();
+            continue;
+        }
+
+        // INSERT [IGNORE] INTO table (columns) VALUES (values), ...;
+        std::string word = Upper(reader.ReadWord());
+        if (word == "IGNORE")
+            word = Upper(reader.ReadWord());
+        if (word != "INTO")
+            return fail("INSERT without INTO");
+
+        std::string table = reader.ReadWord();
+        if (table.empty() || !reader.Consume('('))
+            return fail("INSERT without a column list");
+
+        columns.clear();
+        do
+        {
+            columns.push_back(reader.ReadWord());
+            if (columns.back().empty())
+                return fail("Bad column name");
+        } while (reader.Consume(','));
+
+        if (!reader.Consume(')') || Upper(reader.ReadWord()) != "VALUES")
+            return fail("INSERT without VALUES");
+
+        do
+        {
+            if (!reader.Consume('('))
+                return fail("Expected a row");
+
+            values.clear();
+            do
+            {
+                values.emplace_back();
+                if (!reader.ReadValue(values.back()))
+                    return fail("Bad value");
+            } while (reader.Consume(','));
+
+            if (!reader.Consume(')'))
+                return fail("Unterminated row");
+            if (values.size() != columns.size())
+                return fail("Row and column counts differ");
+            if (!AddRow(table, SqlRow(columns, values), data))
+                return fail(("Incomplete " + table + " row").c_str());
+        } while (reader.Consume(','));
+
+        if (!reader.Consume(';'))
+            return fail("INSERT without ';'");
+    }
+
+    std::sort(data.itemZones.begin(), data.itemZones.end());
+    data.itemZones.erase(std::unique(data.itemZones.begin(), data.itemZones.end()), data.itemZones.end());
+
+    data.ResolveRarity();
+    data.BuildNodeTiers();
+    data.BuildZoneEligibility();
+    return true;
+}
+
+bool GatheringSeed::ParseFile(std::string const& path, GatheringSnapshot& data, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    std::ostringstream sql;
+    sql << in.rdbuf();
+    if (!Parse(sql.str(), data, error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
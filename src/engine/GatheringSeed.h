@@ -0,0 +1,18 @@
+#ifndef MODULE_GATHERING_EXPERIENCE_SEED_H
+#define MODULE_GATHERING_EXPERIENCE_SEED_H
+
+#include "GatheringSnapshot.h"
+
+// Reads the INSERT statements of the module's world SQL files into a
+// snapshot, so the shipped data can be scored without a database. Rows of
+// gathering_experience, gathering_experience_zones, gathering_experience_rarity
+// and gathering_experience_item_zones are taken; every other statement is
+// skipped. Like INSERT IGNORE, the first row of a key wins.
+namespace GatheringSeed
+{
+    // False with a message naming the line when a statement is malformed
+    bool Parse(std::string_view sql, GatheringSnapshot& data, std::string& error);
+    bool ParseFile(std::string const& path, GatheringSnapshot& data, std::string& error);
+}
+
+#endif //MODULE_GATHERING_EXPERIENCE_SEED_H
@@ -0,0 +1,152 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringSnapshot.h"
+#include "GatheringFormula.h"
+
+void GatheringItemTable::Set(uint32 itemId, GatheringItem const& item, std::string_view name)
+{
+    // Loaders read in id order, so this is normally an append
+    auto itr = std::lower_bound(ids.begin(), ids.end(), itemId);
+    std::size_t index = itr - ids.begin();
+
+    if (itr != ids.end() && *itr == itemId)
+    {
+        items[index] = item;
+        if (GetName(index) != name)
+            names[index] = StoreName(name);
+        return;
+    }
+
+    if (itemId < DENSE_ID_LIMIT)
+    {
+        std::size_t word = itemId >> 6;
+        if (word >= presence.size())
+            presence.resize(word + 1, 0);
+        presence[word] |= uint64(1) << (itemId & 63);
+    }
+
+    ids.insert(itr, itemId);
+    items.insert(items.begin() + index, item);
+    names.insert(names.begin() + index, StoreName(name));
+}
+
+bool GatheringItemTable::Erase(uint32 itemId)
+{
+    auto itr = std::lower_bound(ids.begin(), ids.end(), itemId);
+    if (itr == ids.end() || *itr != itemId)
+        return false;
+
+    // The name bytes stay in the arena until the next full load
+    if (itemId < DENSE_ID_LIMIT)
+        presence[itemId >> 6] &= ~(uint64(1) << (itemId & 63));
+
+    std::size_t index = itr - ids.begin();
+    ids.erase(itr);
+    items.erase(items.begin() + index);
+    names.erase(names.begin() + index);
+    return true;
+}
+
+GatheringItemTable::NameRef GatheringItemTable::StoreName(std::string_view name)
+{
+    NameRef ref{ static_cast<uint32>(nameArena.size()), static_cast<uint32>(name.size()) };
+    nameArena.append(name);
+    return ref;
+}
+
+void GatheringSnapshot::ResolveRarity()
+{
+    std::size_t index = 0;
+    for (auto const& [itemId, item] : items)
+    {
+        auto itr = rarityMultipliers.find(itemId);
+        float multiplier = itr != rarityMultipliers.end() ? itr->second : 1.0f;
+        items.SetRarity(index++, multiplier, GatheringFormula::GetRarityLabel(multiplier));
+    }
+}
+
+void GatheringSnapshot::BuildNodeTiers()
+{
+    for (std::vector<GatheringNodeTier>& tiers : nodeTiers)
+        tiers.clear();
+
+    for (auto const& [itemId, item] : items)
+        if (item.profession >= 1 && item.profession <= nodeTiers.size())
+            nodeTiers[item.profession - 1].push_back({ item.requiredSkill, item.baseXP, itemId });
+
+    // A node's main product has the highest base XP among items of its skill
+    for (std::vector<GatheringNodeTier>& tiers : nodeTiers)
+    {
+        std::sort(tiers.begin(), tiers.end(), [](GatheringNodeTier const& a, GatheringNodeTier const& b)
+        {
+            return a.requiredSkill != b.requiredSkill ? a.requiredSkill < b.requiredSkill : a.baseXP > b.baseXP;
+        });
+        tiers.erase(std::unique(tiers.begin(), tiers.end(), [](GatheringNodeTier const& a, GatheringNodeTier const& b)
+        {
+            return a.requiredSkill == b.requiredSkill;
+        }), tiers.end());
+    }
+}
+
+uint32 GatheringSnapshot::FindNodeItem(uint8 profession, uint32 nodeSkill) const
+{
+    if (profession < 1 || profession > nodeTiers.size() || nodeTiers[profession - 1].empty())
+        return 0;
+
+    std::vector<GatheringNodeTier> const& tiers = nodeTiers[profession - 1];
+    auto itr = std::upper_bound(tiers.begin(), tiers.end(), nodeSkill, [](uint32 skill, GatheringNodeTier const& tier)
+    {
+        return skill < tier.requiredSkill;
+    });
+
+    // Nodes below every known item count as the lowest one
+    return itr == tiers.begin() ? itr->itemId : std::prev(itr)->itemId;
+}
+
+void GatheringZoneMatrix::Build(GatheringItemTable const& items, std::vector<std::pair<uint32, uint32>> const& itemZones)
+{
+    columns.clear();
+    bits.clear();
+    rowWords = 0;
+    columnCount = 0;
+    restrictedItems = 0;
+
+    uint32 maxZoneId = 0;
+    for (auto const& [itemId, zoneId] : itemZones)
+        if (zoneId < ZONE_ID_LIMIT && items.IndexOf(itemId) < items.size())
+            maxZoneId = std::max(maxZoneId, zoneId + 1);
+
+    if (!maxZoneId)
+        return;
+
+    columns.assign(maxZoneId, 0);
+    columnCount = 1;
+    for (auto const& [itemId, zoneId] : itemZones)
+        if (zoneId < maxZoneId && !columns[zoneId] && items.IndexOf(itemId) < items.size())
+            columns[zoneId] = static_cast<uint32>(columnCount++);
+
+    rowWords = (columnCount + 63) / 64;
+    bits.assign(items.size() * rowWords, 0);
+
+    std::vector<bool> restricted(items.size(), false);
+    for (auto const& [itemId, zoneId] : itemZones)
+    {
+        std::size_t index = items.IndexOf(itemId);
+        if (zoneId >= maxZoneId || index >= items.size())
+            continue;
+
+        uint32 column = columns[zoneId];
+        bits[index * rowWords + (column >> 6)] |= uint64(1) << (column & 63);
+        if (!restricted[index])
+        {
+            restricted[index] = true;
+            ++restrictedItems;
+        }
+    }
+
+    for (std::size_t index = 0; index < items.size(); ++index)
+        if (!restricted[index])
+            std::fill_n(bits.begin() + index * rowWords, rowWords, ~uint64(0));
+}
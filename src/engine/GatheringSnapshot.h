@@ -0,0 +1,204 @@
+#ifndef GATHERING_SNAPSHOT_H
+#define GATHERING_SNAPSHOT_H
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Fields the loot path reads, packed to 12 bytes. Names live in the table's arena.
+struct GatheringItem
+{
+    float rarityMultiplier{1.0f}; // From gathering_experience_rarity, resolved after loading
+    uint16 baseXP;
+    uint16 requiredSkill;
+    uint8 profession;
+    uint8 rarity;                 // Label of rarityMultiplier: 0 common, 1 Uncommon, 2 Rare
+    uint8 recommendedLevel;
+};
+
+// Gathering items sorted by id. Ids, items and name references are parallel
+// arrays and all names share one arena, so a lookup binary searches a dense
+// array of ids and then reads a single item. A bitset over item ids rejects
+// everything else, which is nearly all loot, before the search.
+class GatheringItemTable
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(GatheringItemTable const* table, std::size_t index) : table(table), index(index) { }
+
+        std::pair<uint32, GatheringItem const&> operator*() const { return { table->ids[index], table->items[index] }; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator==(const_iterator const& other) const { return index == other.index; }
+        bool operator!=(const_iterator const& other) const { return index != other.index; }
+
+    private:
+        GatheringItemTable const* table;
+        std::size_t index;
+    };
+
+    // Ids below this are also tracked in a bitset (at most 512 KB)
+    static constexpr uint32 DENSE_ID_LIMIT = 1 << 22;
+
+    // One bit test for ids below DENSE_ID_LIMIT; true means Find may succeed
+    bool MayContain(uint32 itemId) const
+    {
+        if (itemId >= DENSE_ID_LIMIT)
+            return true;
+
+        std::size_t word = itemId >> 6;
+        return word < presence.size() && (presence[word] >> (itemId & 63) & 1);
+    }
+
+    // Dense index of an item (0 to size() - 1) for per-item side tables, size() if missing
+    std::size_t IndexOf(uint32 itemId) const
+    {
+        if (!MayContain(itemId))
+            return ids.size();
+
+        auto itr = std::lower_bound(ids.begin(), ids.end(), itemId);
+        if (itr == ids.end() || *itr != itemId)
+            return ids.size();
+        return itr - ids.begin();
+    }
+
+    GatheringItem const* Find(uint32 itemId) const
+    {
+        std::size_t index = IndexOf(itemId);
+        return index < ids.size() ? &items[index] : nullptr;
+    }
+
+    // Only valid for items returned by this table
+    std::size_t IndexOf(GatheringItem const& item) const { return &item - items.data(); }
+    std::string_view GetName(GatheringItem const& item) const { return GetName(IndexOf(item)); }
+
+    void Set(uint32 itemId, GatheringItem const& item, std::string_view name);
+    bool Erase(uint32 itemId);
+
+    // Rarity comes from a separate table and is resolved after loading
+    void SetRarity(std::size_t index, float multiplier, uint8 rarity)
+    {
+        items[index].rarityMultiplier = multiplier;
+        items[index].rarity = rarity;
+    }
+
+    std::size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+    const_iterator begin() const { return { this, 0 }; }
+    const_iterator end() const { return { this, ids.size() }; }
+
+private:
+    struct NameRef
+    {
+        uint32 offset;
+        uint32 length;
+    };
+
+    std::string_view GetName(std::size_t index) const { return std::string_view(nameArena).substr(names[index].offset, names[index].length); }
+    NameRef StoreName(std::string_view name);
+
+    std::vector<uint32> ids;
+    std::vector<uint64> presence;
+    std::vector<GatheringItem> items;
+    std::vector<NameRef> names;
+    std::string nameArena;
+};
+
+// Zones each item naturally gathers in, as one row of bits per item (dense
+// item index) and one column per listed zone. Column 0 stands for every zone
+// without rows. Items without rows have their whole row set, so they count
+// as gatherable anywhere, and a lookup is always a single bit test.
+class GatheringZoneMatrix
+{
+public:
+    // Zone ids from here on are not accepted, bounds the zone to column map
+    static constexpr uint32 ZONE_ID_LIMIT = 1 << 16;
+
+    // True when no item is restricted to zones
+    bool empty() const { return bits.empty(); }
+
+    bool IsEligible(std::size_t itemIndex, uint32 zoneId) const
+    {
+        if (bits.empty())
+            return true;
+
+        uint32 column = zoneId < columns.size() ? columns[zoneId] : 0;
+        return bits[itemIndex * rowWords + (column >> 6)] >> (column & 63) & 1;
+    }
+
+    // Restricted items and zones they are listed in
+    std::size_t GetItemCount() const { return restrictedItems; }
+    std::size_t GetZoneCount() const { return columns.empty() ? 0 : columnCount - 1; }
+
+    // itemZones holds (item id, zone id) pairs; items missing from the table are ignored
+    void Build(GatheringItemTable const& items, std::vector<std::pair<uint32, uint32>> const& itemZones);
+
+private:
+    std::vector<uint32> columns; // By zone id
+    std::vector<uint64> bits;
+    std::size_t rowWords{0};
+    std::size_t columnCount{0};
+    std::size_t restrictedItems{0};
+};
+
+// Upper bound of XP experiment cohorts, keeps their counters fixed size
+const uint8 GATHERING_MAX_COHORTS = 16;
+
+// Item a harvested node is scored as, for node-level XP
+struct GatheringNodeTier
+{
+    uint16 requiredSkill;
+    uint16 baseXP;
+    uint32 itemId;
+};
+
+// Everything the module loads from the world database. A snapshot is built
+// in full by the loaders (or the snapshot cache) and then published as a
+// whole, so readers never see a half-loaded table.
+struct GatheringSnapshot
+{
+    GatheringItemTable items;
+    std::map<uint32, float> zoneMultipliers;
+    std::map<uint32, float> rarityMultipliers;
+    std::vector<std::pair<uint8, bool>> professionSettings; // profession id, enabled
+
+    // Per profession (id - 1), sorted by required skill; derived from items
+    std::array<std::vector<GatheringNodeTier>, 4> nodeTiers;
+
+    // XP multipliers per experiment cohort and profession (id - 1). Empty
+    // when no experiment runs, every player is then in cohort 0.
+    std::vector<std::array<float, 4>> cohortMultipliers;
+
+    // Where items naturally gather, (item id, zone id) sorted. Empty when
+    // every item counts in every zone.
+    std::vector<std::pair<uint32, uint32>> itemZones;
+
+    // Compiled from itemZones and the dense item indices
+    GatheringZoneMatrix zoneEligibility;
+
+    // Rebuilds nodeTiers and zoneEligibility, call after changing items
+    void BuildNodeTiers();
+    void BuildZoneEligibility() { zoneEligibility.Build(items, itemZones); }
+
+    // Copies rarityMultipliers into the items, call after changing either
+    void ResolveRarity();
+
+    // Item with the highest required skill not above the node's, 0 if none
+    uint32 FindNodeItem(uint8 profession, uint32 nodeSkill) const;
+
+    // Cohort of a character: a multiplicative hash of its guid scaled onto
+    // the cohort count, stable while the count and seed stay the same
+    uint8 GetCohort(uint32 guidLow, uint32 seed) const
+    {
+        uint64 hash = uint64(guidLow ^ seed) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<uint8>(((hash >> 32) * cohortMultipliers.size()) >> 32);
+    }
+};
+
+#endif // GATHERING_SNAPSHOT_H
@@ -1,6 +1,7 @@
 #include "Fishing.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "GatheringProfiler.h"
 
 FishingExperience* FishingExperience::instance()
 {
@@ -8,149 +9,49 @@ FishingExperience* FishingExperience::instance()
     return &instance;
 }
 
-uint32 FishingExperience::CalculateFishingExperience(Player* player, uint32 itemId)
+uint32 FishingExperience::CalculateFishingExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item)
 {
-    if (!player || !IsFishingItem(itemId))
-        return 0;
-
-    if (!sGatheringExperience->IsFishingEnabled())
-        return 0;
+    GE_PROFILE_SCOPE("CalculateFishingExperience");
 
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
+    if (!player || !sGatheringExperience->IsFishingEnabled())
         return 0;
 
-    uint32 baseXP = std::get<0>(*gatherData);
-    uint16 playerSkill = player->GetSkillValue(SKILL_FISHING);
-    std::string itemName = std::get<3>(*gatherData);
-
-    // Adjust base XP based on skill tiers
-    uint32 adjustedBaseXP = baseXP;
-    std::string adjustReason;
-
-    if (playerSkill > 300)
-    {
-        uint32 skillBasedMin = 200;
-        if (adjustedBaseXP < skillBasedMin)
-        {
-            adjustedBaseXP = skillBasedMin;
-            adjustReason = "minimum for skill > 300";
-        }
-    }
-    else if (playerSkill > 150)
-    {
-        uint32 skillBasedMin = 125;
-        if (adjustedBaseXP < skillBasedMin)
-        {
-            adjustedBaseXP = skillBasedMin;
-            adjustReason = "minimum for skill > 150";
-        }
-    }
-    else if (playerSkill > 75)
-    {
-        uint32 skillBasedMin = 100;
-        if (adjustedBaseXP < skillBasedMin)
-        {
-            adjustedBaseXP = skillBasedMin;
-            adjustReason = "minimum for skill > 75";
-        }
-    }
-
-    // Get recommended level for this fish based on base XP
-    uint32 recommendedLevel = 1;
-    if (baseXP >= 800)           recommendedLevel = 80;  // Northrend
-    else if (baseXP >= 700)      recommendedLevel = 70;  // Northrend
-    else if (baseXP >= 600)      recommendedLevel = 60;  // Outland
-    else if (baseXP >= 500)      recommendedLevel = 50;  // High vanilla
-    else if (baseXP >= 400)      recommendedLevel = 40;  // Mid-high vanilla
-    else if (baseXP >= 300)      recommendedLevel = 30;  // Mid vanilla
-    else if (baseXP >= 200)      recommendedLevel = 20;  // Low vanilla
-    else                         recommendedLevel = 10;  // Beginner
-
-    int32 levelDiff = player->GetLevel() - recommendedLevel;
-    float levelPenalty = 1.0f;
-    std::string penaltyReason;
-
-    if (levelDiff < 0)  // Player is below recommended level
-    {
-        levelPenalty = std::max(0.01f, 1.0f - (std::abs(levelDiff) * 0.03f));
-        penaltyReason = fmt::format("reduced by {}% (level {} < {})", 
-            static_cast<int>((1.0f - levelPenalty) * 100), 
-            player->GetLevel(), 
-            recommendedLevel);
-    }
-    else if (levelDiff > 0)  // Player is above recommended level
-    {
-        levelPenalty = std::max(0.4f, 1.0f - (levelDiff * 0.03f));
-        penaltyReason = fmt::format("reduced by {}% (level {} > {})", 
-            static_cast<int>((1.0f - levelPenalty) * 100), 
-            player->GetLevel(), 
-            recommendedLevel);
-    }
-
-    // Calculate progress bonus (0-30% based on skill)
-    float progressBonus = std::min(0.3f, playerSkill / 450.0f);
-
     // Get zone info
-    std::string zoneName = "Unknown";
+    char const* zoneName = "Unknown";
     uint32 zoneId = player->GetZoneId();
     if (AreaTableEntry const* area = sAreaTableStore.LookupEntry(zoneId))
     {
         zoneName = area->area_name[0];
     }
 
-    float zoneMult = sGatheringExperience->GetZoneMultiplier(zoneId);
+    GatheringXPInput input;
+    input.level = player->GetLevel();
+    input.skill = player->GetSkillValue(SKILL_FISHING);
+    input.zoneMultiplier = GatheringFormula::GetZoneMultiplier(data, zoneId);
 
-    float rarityMult = GetRarityMultiplier(itemId);
-    uint32 normalXP = static_cast<uint32>(adjustedBaseXP * levelPenalty * (1.0f + progressBonus) * zoneMult * rarityMult);
-    uint32 finalXP = std::min(normalXP, MAX_EXPERIENCE_GAIN);
+    GatheringXPResult result = GatheringFormula::ComputeFishing(item, input);
 
     // Logging
-    LOG_INFO("module", "Fishing XP Calculation for {}:", player->GetName());
-    LOG_INFO("module", "- Fish: {} (Item ID: {})", itemName, itemId);
-    LOG_INFO("module", "- Zone: {} (ID: {}) {}", zoneName, zoneId, "");
-    LOG_INFO("module", "- Base XP: {}", baseXP);
-    LOG_INFO("module", "- Level Penalty: {} {}", levelPenalty, 
-        levelPenalty < 1.0f ? fmt::format("({})", penaltyReason) : "");
-    LOG_INFO("module", "- Skill Level: {}", playerSkill);
-    LOG_INFO("module", "- Progress Bonus: {}", progressBonus);
-    LOG_INFO("module", "- Zone Multiplier: {}", zoneMult);
-    LOG_INFO("module", "- Normal XP: {}", normalXP);
-    LOG_INFO("module", "- Final XP: {}", finalXP);
-    if (rarityMult > 1.0f)
-    {
-        std::string rarityText = (rarityMult == 1.5f) ? "Rare" : "Uncommon";
-        LOG_INFO("module", "- Rarity: {} (+{}% bonus)", 
-            rarityText, 
-            static_cast<int>((rarityMult - 1.0f) * 100));
-    }
-
-    return finalXP;
-}
-
-bool FishingExperience::IsFishingItem(uint32 itemId) const
-{
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
-        return false;
-
-    return std::get<2>(*gatherData) == PROF_FISHING;
-}
-
-float FishingExperience::GetRarityMultiplier(uint32 itemId) const
-{
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
-        return 1.0f;
-
-    uint8 rarity = std::get<4>(*gatherData);
-    switch (rarity)
-    {
-        case 1:  // Uncommon
-            return 1.25f;
-        case 2:  // Rare
-            return 1.5f;
-        default: // Common or any invalid value
-            return 1.0f;
-    }
+    LOG_DEBUG("module", "Fishing XP Calculation for {}:", player->GetName());
+    LOG_DEBUG("module", "- Fish: {} (Item ID: {})", data.items.GetName(item), itemId);
+    LOG_DEBUG("module", "- Zone: {} (ID: {}) {}", zoneName, zoneId, "");
+    LOG_DEBUG("module", "- Base XP: {}", item.baseXP);
+    if (result.levelPenalty < 1.0f)
+        LOG_DEBUG("module", "- Level Penalty: {} (reduced by {}% (level {} {} {}))", result.levelPenalty,
+            static_cast<int>((1.0f - result.levelPenalty) * 100), input.level,
+            input.level < item.recommendedLevel ? "<" : ">", item.recommendedLevel);
+    else
+        LOG_DEBUG("module", "- Level Penalty: {}", result.levelPenalty);
+    LOG_DEBUG("module", "- Skill Level: {}", input.skill);
+    LOG_DEBUG("module", "- Progress Bonus: {}", result.progressBonus);
+    LOG_DEBUG("module", "- Zone Multiplier: {}", result.zoneMultiplier);
+    LOG_DEBUG("module", "- Normal XP: {}", result.normalXP);
+    LOG_DEBUG("module", "- Final XP: {}", result.finalXP);
+    if (result.rarityMultiplier != 1.0f)
+    {
+        LOG_DEBUG("module", "- Rarity: {} (x{})",
+            item.rarity == 2 ? "Rare" : item.rarity == 1 ? "Uncommon" : "Common", result.rarityMultiplier);
+    }
+
+    return result.finalXP;
 } 
\ No newline at end of file
@@ -9,15 +9,13 @@ class FishingExperience
 public:
     static FishingExperience* instance();
     
-    uint32 CalculateFishingExperience(Player* player, uint32 itemId);
-    bool IsFishingItem(uint32 itemId) const;
+    // item is itemId's entry in data, looked up once by the loot handler
+    uint32 CalculateFishingExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item);
 
 private:
     FishingExperience() = default;
     ~FishingExperience() { }
     static FishingExperience* _instance;
-    
-    float GetRarityMultiplier(uint32 itemId) const;
 };
 
 #define sFishingExperience FishingExperience::instance()
@@ -1,6 +1,7 @@
 #include "Herbalism.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "GatheringProfiler.h"
 
 HerbalismExperience* HerbalismExperience::instance()
 {
@@ -8,71 +9,33 @@ HerbalismExperience* HerbalismExperience::instance()
     return &instance;
 }
 
-uint32 HerbalismExperience::CalculateHerbalismExperience(Player* player, uint32 itemId)
+uint32 HerbalismExperience::CalculateHerbalismExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item)
 {
-    if (!player || !IsHerbalismItem(itemId))
-        return 0;
-
-    if (!sGatheringExperience->IsHerbalismEnabled())
-        return 0;
+    GE_PROFILE_SCOPE("CalculateHerbalismExperience");
 
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
+    if (!player || !sGatheringExperience->IsHerbalismEnabled())
         return 0;
 
-    uint32 baseXP = std::get<0>(*gatherData);
-    uint16 playerSkill = player->GetSkillValue(SKILL_HERBALISM);
-    std::string itemName = std::get<3>(*gatherData);
-
-    // Calculate progress bonus (0-30% based on skill)
-    float progressBonus = std::min(0.3f, playerSkill / 450.0f);
+    GatheringXPInput input;
+    input.level = player->GetLevel();
+    input.skill = player->GetSkillValue(SKILL_HERBALISM);
+    input.zoneMultiplier = 1.0f; // Zone multipliers only apply to fishing
 
-    float rarityMult = GetRarityMultiplier(itemId);
-
-    uint32 normalXP = static_cast<uint32>(baseXP * (1.0f + progressBonus) * rarityMult);
-    uint32 finalXP = std::min(normalXP, MAX_EXPERIENCE_GAIN);
+    GatheringXPResult result = GatheringFormula::ComputeGathering(item, input);
 
     // Detailed logging
-    LOG_INFO("module", "Herbalism XP Calculation for {}:", player->GetName());
-    LOG_INFO("module", "- Item: {} (Item ID: {})", itemName, itemId);
-    LOG_INFO("module", "- Base XP: {}", baseXP);
-    LOG_INFO("module", "- Progress Bonus: {}", progressBonus);
-    LOG_INFO("module", "- Normal XP: {}", normalXP);
-    LOG_INFO("module", "- Final XP: {}", finalXP);
-    if (rarityMult > 1.0f)
+    LOG_DEBUG("module", "Herbalism XP Calculation for {}:", player->GetName());
+    LOG_DEBUG("module", "- Item: {} (Item ID: {})", data.items.GetName(item), itemId);
+    LOG_DEBUG("module", "- Base XP: {}", item.baseXP);
+    LOG_DEBUG("module", "- Level Penalty: {} (recommended level {})", result.levelPenalty, item.recommendedLevel);
+    LOG_DEBUG("module", "- Progress Bonus: {}", result.progressBonus);
+    LOG_DEBUG("module", "- Normal XP: {}", result.normalXP);
+    LOG_DEBUG("module", "- Final XP: {}", result.finalXP);
+    if (result.rarityMultiplier != 1.0f)
     {
-        std::string rarityText = (rarityMult == 1.5f) ? "Rare" : "Uncommon";
-        LOG_INFO("module", "- Rarity: {} (+{}% bonus)", 
-            rarityText, 
-            static_cast<int>((rarityMult - 1.0f) * 100));
+        LOG_DEBUG("module", "- Rarity: {} (x{})",
+            item.rarity == 2 ? "Rare" : item.rarity == 1 ? "Uncommon" : "Common", result.rarityMultiplier);
     }
 
-    return finalXP;
-}
-
-bool HerbalismExperience::IsHerbalismItem(uint32 itemId) const
-{
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
-        return false;
-
-    return std::get<2>(*gatherData) == PROF_HERBALISM;
-}
-
-float HerbalismExperience::GetRarityMultiplier(uint32 itemId) const
-{
-    auto gatherData = sGatheringExperience->GetGatheringData(itemId);
-    if (!gatherData)
-        return 1.0f;
-
-    uint8 rarity = std::get<4>(*gatherData);
-    switch (rarity)
-    {
-        case 1:  // Uncommon
-            return 1.25f;
-        case 2:  // Rare
-            return 1.5f;
-        default: // Common or any invalid value
-            return 1.0f;
-    }
+    return result.finalXP;
 } 
\ No newline at end of file
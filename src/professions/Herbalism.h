@@ -7,9 +7,8 @@ class HerbalismExperience
 {
 public:
     static HerbalismExperience* instance();
-    uint32 CalculateHerbalismExperience(Player* player, uint32 itemId);
-    bool IsHerbalismItem(uint32 itemId) const;
-    float GetRarityMultiplier(uint32 itemId) const;
+    // item is itemId's entry in data, looked up once by the loot handler
+    uint32 CalculateHerbalismExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item);
 };
 
 #define sHerbalismExperience HerbalismExperience::instance()
@@ -7,9 +7,8 @@ class MiningExperience
 {
 public:
     static MiningExperience* instance();
-    uint32 CalculateMiningExperience(Player* player, uint32 itemId);
-    bool IsMiningItem(uint32 itemId) const;
-    float GetRarityMultiplier(uint32 itemId) const;
+    // item is itemId's entry in data, looked up once by the loot handler
+    uint32 CalculateMiningExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item);
 };
 
 #define sMiningExperience MiningExperience::instance()
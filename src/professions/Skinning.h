@@ -9,15 +9,13 @@ class SkinningExperience
 public:
     static SkinningExperience* instance();
     
-    uint32 CalculateSkinningExperience(Player* player, uint32 itemId);
-    bool IsSkinningItem(uint32 itemId) const;
+    // item is itemId's entry in data, looked up once by the loot handler
+    uint32 CalculateSkinningExperience(Player* player, GatheringSnapshot const& data, uint32 itemId, GatheringItem const& item);
 
 private:
     SkinningExperience() = default;
     ~SkinningExperience() { }
     static SkinningExperience* _instance;
-    
-    float GetRarityMultiplier(uint32 itemId) const;
 };
 
 #define sSkinningExperience SkinningExperience::instance()
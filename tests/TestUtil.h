@@ -0,0 +1,25 @@
+#ifndef GATHERING_TESTS_UTIL_H
+#define GATHERING_TESTS_UTIL_H
+
+#include <cmath>
+#include <cstdio>
+
+// Minimal checks, a failing one is reported and fails the test at exit
+inline int testFailures = 0;
+
+#define CHECK(expr) \
+    do { if (!(expr)) { std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); ++testFailures; } } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { auto va = (a); auto vb = (b); if (!(va == vb)) { std::printf("%s:%d: %s == %s failed (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, (long long)va, (long long)vb); ++testFailures; } } while (0)
+
+#define CHECK_NEAR(a, b) \
+    do { double va = (a); double vb = (b); if (std::fabs(va - vb) > 1e-4) { std::printf("%s:%d: %s ~= %s failed (%g vs %g)\n", __FILE__, __LINE__, #a, #b, va, vb); ++testFailures; } } while (0)
+
+inline int TestResult(char const* name)
+{
+    std::printf("%s: %s\n", name, testFailures ? "FAILED" : "passed");
+    return testFailures ? 1 : 0;
+}
+
+#endif // GATHERING_TESTS_UTIL_H
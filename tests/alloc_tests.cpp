@@ -0,0 +1,188 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringAntiBot.h"
+#include "GatheringCapture.h"
+#include "GatheringCaps.h"
+#include "GatheringEvents.h"
+#include "GatheringHeatmap.h"
+#include "GatheringLeaderboard.h"
+#include "GatheringMetrics.h"
+#include "GatheringNotify.h"
+#include "GatheringPlayerData.h"
+#include "GatheringScorer.h"
+#include "GatheringStats.h"
+#include "GatheringSeed.h"
+#include "TestUtil.h"
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <vector>
+
+// Every allocation of the process is counted, the loot path must not make any
+namespace
+{
+    std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace
+{
+    struct TestGatherer
+    {
+        GatheringGatherer gatherer;
+        GatheringPlayerData data;
+        GatheringPlayerState state;
+    };
+
+    // OnLootItem and AwardExperience without the Player: the same snapshot
+    // lookups and formula as the profession calculators, then the scorer
+    uint32 Loot(GatheringSnapshot const& data, TestGatherer& player, uint32 itemId, ObjectGuid lootGuid)
+    {
+        if (!data.items.MayContain(itemId))
+            return 0;
+
+        GatheringItem const* item = data.items.Find(itemId);
+        if (!item)
+            return 0;
+
+        uint32 xp = GatheringFormula::Compute(*item, GatheringFormula::MakeInput(data, *item, player.state)).finalXP;
+        player.gatherer.skill = player.state.skills[item->profession - 1];
+        return sGatheringScorer->Score(player.gatherer, data, itemId, *item, 1, xp, lootGuid);
+    }
+
+    // OnUpdateGatheringSkill: a harvested node scored through its tier item
+    uint32 Harvest(GatheringSnapshot const& data, TestGatherer& player, uint8 profession)
+    {
+        uint32 skill = player.state.skills[profession - 1];
+        uint32 itemId = data.FindNodeItem(profession, skill);
+        GatheringItem const* item = itemId ? data.items.Find(itemId) : nullptr;
+        if (!item)
+            return 0;
+
+        GatheringXPInput input;
+        input.level = player.state.level;
+        input.skill = skill;
+        input.zoneMultiplier = 1.0f;
+
+        float colorFactor = GatheringFormula::GetNodeColorFactor(skill, skill + 100, skill + 50, skill + 25);
+        uint32 xp = static_cast<uint32>(GatheringFormula::Compute(*item, input).finalXP * colorFactor);
+        player.gatherer.skill = skill;
+        return sGatheringScorer->Score(player.gatherer, data, itemId, *item, 1, xp, ObjectGuid::Empty, colorFactor);
+    }
+}
+
+int main()
+{
+    GatheringSnapshot data;
+    std::string error;
+    if (!GatheringSeed::ParseFile(GATHERING_SEED_SQL, data, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+
+    // Exercise the optional tables too
+    data.cohortMultipliers = { { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.1f, 1.2f, 1.3f, 1.4f } };
+    data.itemZones = { { 2770, 1 }, { 2770, 12 }, { 6291, 1519 } };
+    data.BuildZoneEligibility();
+
+    // Every recorder the scorer feeds is on, and the caps and the bot check
+    // are low enough to be hit
+    sConfigMgr->SetOption("GatheringExperience.ItemZones.Factor", "0.5");
+    sConfigMgr->SetOption("GatheringExperience.AntiBot.MinSamples", "10");
+    sConfigMgr->SetOption("GatheringExperience.DailyCap.Total", "500000");
+    sConfigMgr->SetOption("GatheringExperience.DailyCap.Mining", "100000");
+    sConfigMgr->SetOption("GatheringExperience.Heatmap.Enable", "1");
+    sGatheringScorer->LoadConfig();
+    sGatheringAntiBot->LoadConfig();
+    sGatheringCaps->LoadConfig();
+    sGatheringNotify->LoadConfig();
+    sGatheringHeatmap->LoadConfig();
+
+    // What the module sets up at startup; the database has no rows
+    sGatheringLeaderboard->SetSize(10);
+    sGatheringLeaderboard->LoadFromDB();
+    sGatheringEvents->LoadFromDB();
+
+    std::filesystem::path capture = std::filesystem::temp_directory_path() / "gathering_alloc_tests.bin";
+    sGatheringCapture->Configure(capture.string(), 4096);
+
+    std::vector<TestGatherer> players(8);
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        players[i].gatherer.guid = ObjectGuid::Create<HighGuid::Player>(i + 1);
+        players[i].gatherer.data = &players[i].data;
+        players[i].gatherer.x = 100.0f * i;
+        players[i].gatherer.y = -50.0f * i;
+    }
+
+    std::array<uint32, GATHERING_PROFESSION_COUNT> looted{};
+    std::array<uint32, GATHERING_PROFESSION_COUNT> harvested{};
+    uint64 xp = 0;
+    uint32 node = 0;
+
+    std::size_t before = allocations.load();
+    for (uint32 level : { 1u, 40u, 80u })
+    {
+        for (uint32 zoneId : { 1u, 12u, 1519u, 4812u })
+        {
+            for (TestGatherer& player : players)
+            {
+                player.state = { level, { level * 5, level * 5, level * 5, level * 5 }, zoneId };
+                player.gatherer.level = level;
+                player.gatherer.zoneId = zoneId;
+
+                for (auto [itemId, item] : data.items)
+                {
+                    uint32 gained = Loot(data, player, itemId, ObjectGuid::Create<HighGuid::GameObject>(itemId, ++node));
+                    xp += gained;
+                    ++looted[item.profession - 1];
+
+                    // Loot that is no gathering item, nearly all of it
+                    xp += Loot(data, player, itemId + 1000000, ObjectGuid::Create<HighGuid::Unit>(itemId, ++node));
+                }
+
+                for (uint8 profession : { PROF_MINING, PROF_HERBALISM, PROF_SKINNING })
+                {
+                    if (Harvest(data, player, profession))
+                        ++harvested[profession - 1];
+                }
+            }
+        }
+    }
+    std::size_t made = allocations.load() - before;
+
+    // Loading allocated, so the counter is the one in use
+    CHECK(before > 0);
+    for (uint32 count : looted)
+        CHECK(count > 0);
+    for (uint8 profession : { PROF_MINING, PROF_HERBALISM, PROF_SKINNING })
+        CHECK(harvested[profession - 1] > 0);
+    CHECK(xp > 0);
+
+    // The gathers reached the recorders
+    CHECK(sGatheringCapture->IsEnabled());
+    CHECK(players[0].data.stats[PROF_MINING - 1].gathers > 0);
+    CHECK(players[0].data.rate.flagged);
+    CHECK(players[0].data.notice.queued);
+    CHECK(sGatheringCaps->GetTotalXP(&players[0].data) > 0);
+
+    CHECK_EQ(made, std::size_t(0));
+
+    sGatheringCapture->Configure("", 0);
+    std::filesystem::remove(capture);
+    return TestResult("alloc_tests");
+}
@@ -0,0 +1,237 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringFormula.h"
+#include "GatheringSeed.h"
+#include "TestUtil.h"
+
+namespace
+{
+    GatheringItem MakeItem(uint8 profession, uint16 baseXP, uint8 recommendedLevel, float rarityMultiplier = 1.0f)
+    {
+        GatheringItem item{};
+        item.rarityMultiplier = rarityMultiplier;
+        item.baseXP = baseXP;
+        item.requiredSkill = 1;
+        item.profession = profession;
+        item.rarity = GatheringFormula::GetRarityLabel(rarityMultiplier);
+        item.recommendedLevel = recommendedLevel;
+        return item;
+    }
+
+    void TestLevelPenalty()
+    {
+        CHECK_NEAR(GatheringFormula::GetLevelPenalty(10, 10), 1.0f);
+        CHECK_NEAR(GatheringFormula::GetLevelPenalty(5, 10), 0.85f);
+        CHECK_NEAR(GatheringFormula::GetLevelPenalty(1, 80), GatheringFormula::MIN_UNDERLEVEL_PENALTY);
+        CHECK_NEAR(GatheringFormula::GetLevelPenalty(80, 10), GatheringFormula::MIN_OVERLEVEL_PENALTY);
+        CHECK_EQ(GatheringFormula::GetDefaultRecommendedLevel(50), 10u);
+        CHECK_EQ(GatheringFormula::GetDefaultRecommendedLevel(450), 40u);
+        CHECK_EQ(GatheringFormula::GetDefaultRecommendedLevel(900), 80u);
+    }
+
+    void TestGatheringFormula()
+    {
+        GatheringXPInput input{ 10, 450, 3.0f };
+
+        // Mining, herbalism and skinning share the formula and ignore the zone
+        for (uint8 profession : { PROF_MINING, PROF_HERBALISM, PROF_SKINNING })
+        {
+            GatheringXPResult result = GatheringFormula::Compute(MakeItem(profession, 100, 10, 1.5f), input);
+            CHECK_NEAR(result.progressBonus, 0.3f);
+            CHECK_NEAR(result.zoneMultiplier, 1.0f);
+            CHECK_NEAR(result.rarityMultiplier, 1.5f);
+            CHECK_EQ(result.finalXP, 195u);
+        }
+
+        // Rarity multipliers apply as configured, not rounded to a label
+        CHECK_EQ(GatheringFormula::Compute(MakeItem(PROF_MINING, 100, 10, 1.1f), input).finalXP, 143u);
+        CHECK_EQ(GatheringFormula::Compute(MakeItem(PROF_MINING, 100, 10, 2.0f), input).finalXP, 260u);
+        CHECK_EQ(GatheringFormula::Compute(MakeItem(PROF_MINING, 100, 10, 0.5f), input).finalXP, 65u);
+        CHECK_EQ(GatheringFormula::GetRarityLabel(0.5f), 0);
+        CHECK_EQ(GatheringFormula::GetRarityLabel(1.1f), 1);
+        CHECK_EQ(GatheringFormula::GetRarityLabel(2.5f), 2);
+
+        // Capped at the maximum gain
+        GatheringXPResult capped = GatheringFormula::Compute(MakeItem(PROF_MINING, 60000, 10, 1.5f), input);
+        CHECK(capped.normalXP > MAX_EXPERIENCE_GAIN);
+        CHECK_EQ(capped.finalXP, MAX_EXPERIENCE_GAIN);
+
+        // Unknown professions give nothing
+        CHECK_EQ(GatheringFormula::Compute(MakeItem(9, 100, 10), input).finalXP, 0u);
+    }
+
+    void TestFishingFormula()
+    {
+        GatheringItem fish = MakeItem(PROF_FISHING, 50, 10);
+
+        // Skill tiers raise low base XP
+        CHECK_EQ(GatheringFormula::ComputeFishing(fish, { 10, 50, 1.0f }).adjustedBaseXP, 50u);
+        CHECK_EQ(GatheringFormula::ComputeFishing(fish, { 10, 100, 1.0f }).adjustedBaseXP, 100u);
+        CHECK_EQ(GatheringFormula::ComputeFishing(fish, { 10, 200, 1.0f }).adjustedBaseXP, 125u);
+        CHECK_EQ(GatheringFormula::ComputeFishing(fish, { 10, 301, 1.0f }).adjustedBaseXP, 200u);
+
+        GatheringXPResult zoned = GatheringFormula::Compute(fish, { 10, 301, 2.0f });
+        CHECK_NEAR(zoned.zoneMultiplier, 2.0f);
+        CHECK_EQ(zoned.finalXP, 520u);
+    }
+
+    void TestNodeColors()
+    {
+        CHECK_NEAR(GatheringFormula::GetNodeColorFactor(50, 200, 150, 100), GatheringFormula::NODE_ORANGE_FACTOR);
+        CHECK_NEAR(GatheringFormula::GetNodeColorFactor(100, 200, 150, 100), GatheringFormula::NODE_YELLOW_FACTOR);
+        CHECK_NEAR(GatheringFormula::GetNodeColorFactor(150, 200, 150, 100), GatheringFormula::NODE_GREEN_FACTOR);
+        CHECK_NEAR(GatheringFormula::GetNodeColorFactor(250, 200, 150, 100), GatheringFormula::NODE_GRAY_FACTOR);
+    }
+
+    void TestItemTable()
+    {
+        GatheringItemTable table;
+        table.Set(2770, MakeItem(PROF_MINING, 10, 10), "Copper Ore");
+        table.Set(765, MakeItem(PROF_HERBALISM, 10, 10), "Silverleaf");
+        table.Set(5000000, MakeItem(PROF_FISHING, 10, 10), "Above the dense limit");
+
+        CHECK_EQ(table.size(), std::size_t(3));
+        CHECK(table.Find(2770) && table.Find(2770)->profession == PROF_MINING);
+        CHECK(table.Find(5000000) != nullptr);
+        CHECK(!table.MayContain(2771));
+        CHECK(table.Find(2771) == nullptr);
+        CHECK_EQ(table.IndexOf(765), std::size_t(0));
+        CHECK(table.GetName(*table.Find(765)) == "Silverleaf");
+
+        CHECK(table.Erase(765));
+        CHECK(!table.Erase(765));
+        CHECK(table.Find(765) == nullptr);
+        CHECK_EQ(table.IndexOf(765), table.size());
+        CHECK(table.GetName(*table.Find(2770)) == "Copper Ore");
+    }
+
+    void TestSnapshot()
+    {
+        GatheringSnapshot data;
+        data.items.Set(2770, MakeItem(PROF_MINING, 10, 10), "Copper Ore");
+        data.items.Set(2771, MakeItem(PROF_MINING, 40, 20), "Tin Ore");
+        data.items.Set(2775, MakeItem(PROF_MINING, 30, 20), "Silver Ore");
+        data.items.Set(6291, MakeItem(PROF_FISHING, 10, 10), "Raw Brilliant Smallfish");
+        data.zoneMultipliers[12] = 1.5f;
+
+        // Node tiers take the item with the most base XP per required skill
+        GatheringItem tin = *data.items.Find(2771);
+        tin.requiredSkill = 65;
+        data.items.Set(2771, tin, "Tin Ore");
+        GatheringItem silver = *data.items.Find(2775);
+        silver.requiredSkill = 65;
+        data.items.Set(2775, silver, "Silver Ore");
+        data.BuildNodeTiers();
+        CHECK_EQ(data.FindNodeItem(PROF_MINING, 0), 2770u);
+        CHECK_EQ(data.FindNodeItem(PROF_MINING, 64), 2770u);
+        CHECK_EQ(data.FindNodeItem(PROF_MINING, 70), 2771u);
+        CHECK_EQ(data.FindNodeItem(PROF_HERBALISM, 70), 0u);
+
+        // Rarity multipliers are copied into the items, and reset once removed
+        data.rarityMultipliers[2771] = 1.1f;
+        data.rarityMultipliers[2775] = 3.0f;
+        data.ResolveRarity();
+        CHECK_NEAR(data.items.Find(2770)->rarityMultiplier, 1.0f);
+        CHECK_NEAR(data.items.Find(2771)->rarityMultiplier, 1.1f);
+        CHECK_EQ(data.items.Find(2771)->rarity, 1);
+        CHECK_NEAR(data.items.Find(2775)->rarityMultiplier, 3.0f);
+        CHECK_EQ(data.items.Find(2775)->rarity, 2);
+        data.rarityMultipliers.erase(2775);
+        data.ResolveRarity();
+        CHECK_NEAR(data.items.Find(2775)->rarityMultiplier, 1.0f);
+        CHECK_EQ(data.items.Find(2775)->rarity, 0);
+
+        // Zone multipliers only reach fishing
+        GatheringPlayerState player{ 10, { 50, 50, 50, 50 }, 12 };
+        CHECK_NEAR(GatheringFormula::MakeInput(data, *data.items.Find(6291), player).zoneMultiplier, 1.5f);
+        CHECK_NEAR(GatheringFormula::MakeInput(data, *data.items.Find(2770), player).zoneMultiplier, 1.0f);
+        CHECK_EQ(GatheringFormula::MakeInput(data, *data.items.Find(2770), player).skill, 50u);
+    }
+
+    void TestZoneMatrix()
+    {
+        GatheringSnapshot data;
+        for (uint32 itemId : { 100u, 200u, 300u })
+            data.items.Set(itemId, MakeItem(PROF_FISHING, 10, 10), "Fish");
+
+        data.BuildZoneEligibility();
+        CHECK(data.zoneEligibility.empty());
+        CHECK(data.zoneEligibility.IsEligible(0, 5));
+
+        // Item 999 is unknown and zone 70000 out of range, both are ignored
+        data.itemZones = { { 100, 12 }, { 100, 40 }, { 300, 12 }, { 999, 1 }, { 200, 70000 } };
+        for (uint32 zoneId = 1000; zoneId < 1100; ++zoneId)
+            data.itemZones.emplace_back(300, zoneId);
+        data.BuildZoneEligibility();
+
+        GatheringZoneMatrix const& matrix = data.zoneEligibility;
+        CHECK_EQ(matrix.GetItemCount(), std::size_t(2));
+        CHECK_EQ(matrix.GetZoneCount(), std::size_t(102));
+        CHECK(matrix.IsEligible(data.items.IndexOf(100), 12));
+        CHECK(matrix.IsEligible(data.items.IndexOf(100), 40));
+        CHECK(!matrix.IsEligible(data.items.IndexOf(100), 1099));
+        CHECK(!matrix.IsEligible(data.items.IndexOf(100), 5));
+        CHECK(!matrix.IsEligible(data.items.IndexOf(100), 99999));
+        CHECK(matrix.IsEligible(data.items.IndexOf(200), 5));
+        CHECK(matrix.IsEligible(data.items.IndexOf(200), 99999));
+        CHECK(matrix.IsEligible(data.items.IndexOf(300), 1099));
+        CHECK(!matrix.IsEligible(data.items.IndexOf(300), 40));
+    }
+
+    void TestSeed()
+    {
+        std::string sql =
+            "SET @OLD_SQL_MODE=@@SQL_MODE; -- a comment with a ; and a '\n"
+            "CREATE TABLE `x` (`a` INT) /* 'quoted' */;\n"
+            "INSERT IGNORE INTO `gathering_experience` (item_id, base_xp, required_skill, profession, name) VALUES\n"
+            "(2770, 100, 1, 1, 'Copper Ore'),\n"
+            "-- Interleaved comment\n"
+            "(2449, 450, 1, 2, 'Arthas'' Tears'),\n"
+            "(2770, 999, 1, 1, 'Duplicate');\n"
+            "insert into gathering_experience (`item_id`, `base_xp`, `required_skill`, `profession`, `recommended_level`, `name`) values (6291, 50, 1, 4, 25, \"Smallfish\");\n"
+            "INSERT IGNORE INTO `gathering_experience_zones` (zone_id, multiplier, name) VALUES (12, 1.5, 'Elwynn');\n"
+            "INSERT IGNORE INTO `gathering_experience_rarity` (`item_id`, `multiplier`) VALUES (2449, 2);   -- Arthas' Tears\n"
+            "INSERT INTO `gathering_experience_item_zones` (item_id, zone_id) VALUES (6291, 12), (6291, 12);\n";
+
+        GatheringSnapshot data;
+        std::string error;
+        CHECK(GatheringSeed::Parse(sql, data, error));
+        CHECK(error.empty());
+        CHECK_EQ(data.items.size(), std::size_t(3));
+
+        // First row of a key wins, missing levels are derived from base XP
+        GatheringItem const* copper = data.items.Find(2770);
+        CHECK(copper && copper->baseXP == 100 && copper->recommendedLevel == 10);
+        CHECK(data.items.GetName(*data.items.Find(2449)) == "Arthas' Tears");
+        CHECK_EQ(data.items.Find(2449)->recommendedLevel, 40);
+        CHECK_EQ(data.items.Find(6291)->recommendedLevel, 25);
+        CHECK_NEAR(data.zoneMultipliers[12], 1.5f);
+        CHECK_NEAR(data.rarityMultipliers[2449], 2.0f);
+        CHECK_NEAR(data.items.Find(2449)->rarityMultiplier, 2.0f);
+        CHECK_NEAR(data.items.Find(2770)->rarityMultiplier, 1.0f);
+        CHECK_EQ(data.itemZones.size(), std::size_t(1));
+        CHECK(!data.zoneEligibility.empty());
+        CHECK_EQ(data.FindNodeItem(PROF_MINING, 1), 2770u);
+
+        GatheringSnapshot broken;
+        CHECK(!GatheringSeed::Parse("INSERT INTO `gathering_experience` (item_id, base_xp) VALUES (1, 2);", broken, error));
+        CHECK(error.find("line 1") != std::string::npos);
+        CHECK(!GatheringSeed::Parse("\nINSERT INTO `gathering_experience_zones` (zone_id, multiplier) VALUES (1, 2", broken, error));
+        CHECK(error.find("line 2") != std::string::npos);
+    }
+}
+
+int main()
+{
+    TestLevelPenalty();
+    TestGatheringFormula();
+    TestFishingFormula();
+    TestNodeColors();
+    TestItemTable();
+    TestSnapshot();
+    TestZoneMatrix();
+    TestSeed();
+    return TestResult("engine_tests");
+}
@@ -0,0 +1,63 @@
+/*
+*Copyright (C) 2024+ xSparky911x, Thaxtin, released under GNU AGPL v3 license: https://github.com/xSparky911x/mod-gathering-experience/blob/master/LICENSE
+*/
+
+#include "GatheringFormula.h"
+#include "GatheringGoldenTable.h"
+#include "GatheringSeed.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <sstream>
+
+// Scores the shipped seed data against the checked in golden table.
+// Run with --write after an intended formula or seed change to record the
+// new table, and review its diff.
+int main(int argc, char** argv)
+{
+    GatheringSnapshot data;
+    std::string error;
+    if (!GatheringSeed::ParseFile(GATHERING_SEED_SQL, data, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+
+    CHECK(data.items.size() > 100);
+    CHECK(!data.zoneMultipliers.empty());
+
+    if (argc > 1 && std::string(argv[1]) == "--write")
+    {
+        std::ofstream out(GATHERING_GOLDEN_TABLE, std::ios::binary | std::ios::trunc);
+        out << GatheringGolden::Format(data);
+        std::printf("Recorded %zu items to %s\n", data.items.size(), GATHERING_GOLDEN_TABLE);
+        return out ? 0 : 1;
+    }
+
+    std::ifstream in(GATHERING_GOLDEN_TABLE, std::ios::binary);
+    GatheringGolden::Checker checker;
+    if (!checker.Load(in, error))
+    {
+        std::printf("%s: %s\n", GATHERING_GOLDEN_TABLE, error.c_str());
+        return 1;
+    }
+
+    for (auto [itemId, item] : data.items)
+        checker.Check(itemId, item);
+
+    GatheringGolden::Report const& report = checker.Finish();
+    for (GatheringGolden::Difference const& difference : report.differences)
+    {
+        std::printf("item %u level %u skill %u zone %s: expected %s, got %s\n", difference.itemId, difference.level, difference.skill,
+            GatheringGolden::FormatZone(difference.zoneMultiplier).c_str(),
+            difference.expected ? std::to_string(*difference.expected).c_str() : "no row",
+            difference.actual ? std::to_string(*difference.actual).c_str() : "no row");
+    }
+    for (uint32 itemId : report.added)
+        std::printf("item %u is not in the golden table\n", itemId);
+    for (uint32 itemId : report.removed)
+        std::printf("item %u is only in the golden table\n", itemId);
+
+    CHECK_EQ(report.checked, data.items.size());
+    CHECK(report.Passed());
+    return TestResult("golden_tests");
+}
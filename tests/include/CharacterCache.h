@@ -0,0 +1,21 @@
+#ifndef GATHERING_TESTS_CHARACTER_CACHE_H
+#define GATHERING_TESTS_CHARACTER_CACHE_H
+
+#include "ObjectGuid.h"
+#include <string>
+
+class CharacterCache
+{
+public:
+    static CharacterCache* instance()
+    {
+        static CharacterCache instance;
+        return &instance;
+    }
+
+    bool GetCharacterNameByGuid(ObjectGuid /*guid*/, std::string& /*name*/) { return false; }
+};
+
+#define sCharacterCache CharacterCache::instance()
+
+#endif // GATHERING_TESTS_CHARACTER_CACHE_H
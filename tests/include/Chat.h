@@ -0,0 +1,27 @@
+#ifndef GATHERING_TESTS_CHAT_H
+#define GATHERING_TESTS_CHAT_H
+
+#include "Player.h"
+#include "StringFormat.h"
+#include <string_view>
+
+class ChatHandler
+{
+public:
+    explicit ChatHandler(WorldSession* session) : session(session) { }
+    virtual ~ChatHandler() = default;
+
+    WorldSession* GetSession() const { return session; }
+
+    virtual void SendSysMessage(std::string_view /*str*/, bool /*escapeCharacters*/ = false) { }
+
+    template<typename... Args>
+    void PSendSysMessage(std::string_view format, Args&&... args) { SendSysMessage(Acore::StringFormat(format, std::forward<Args>(args)...)); }
+
+    void SendGlobalGMSysMessage(char const* /*str*/) { }
+
+private:
+    WorldSession* session;
+};
+
+#endif // GATHERING_TESTS_CHAT_H
@@ -0,0 +1,39 @@
+#ifndef GATHERING_TESTS_CONFIG_H
+#define GATHERING_TESTS_CONFIG_H
+
+#include <map>
+#include <sstream>
+#include <string>
+
+// Options are set by the test before the LoadConfig calls; unset ones
+// return their default
+class ConfigMgr
+{
+public:
+    static ConfigMgr* instance()
+    {
+        static ConfigMgr instance;
+        return &instance;
+    }
+
+    void SetOption(std::string const& name, std::string const& value) { options[name] = value; }
+
+    template<typename T>
+    T GetOption(std::string const& name, T const& def, bool /*showLogs*/ = true) const
+    {
+        auto itr = options.find(name);
+        if (itr == options.end())
+            return def;
+
+        T value{};
+        std::istringstream(itr->second) >> value;
+        return value;
+    }
+
+private:
+    std::map<std::string, std::string> options;
+};
+
+#define sConfigMgr ConfigMgr::instance()
+
+#endif // GATHERING_TESTS_CONFIG_H
@@ -0,0 +1,43 @@
+#ifndef GATHERING_TESTS_DATA_MAP_H
+#define GATHERING_TESTS_DATA_MAP_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Per object data of scripts, keyed by name
+class DataMap
+{
+public:
+    class Base
+    {
+    public:
+        virtual ~Base() = default;
+    };
+
+    template<class T>
+    T* Get(std::string const& key) const
+    {
+        auto itr = container.find(key);
+        return itr != container.end() ? dynamic_cast<T*>(itr->second.get()) : nullptr;
+    }
+
+    template<class T>
+    T* GetDefault(std::string const& key)
+    {
+        if (T* value = Get<T>(key))
+            return value;
+
+        T* value = new T();
+        container[key].reset(value);
+        return value;
+    }
+
+    void Set(std::string const& key, Base* value) { container[key].reset(value); }
+    void Erase(std::string const& key) { container.erase(key); }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<Base>> container;
+};
+
+#endif // GATHERING_TESTS_DATA_MAP_H
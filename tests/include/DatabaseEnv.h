@@ -0,0 +1,103 @@
+#ifndef GATHERING_TESTS_DATABASE_ENV_H
+#define GATHERING_TESTS_DATABASE_ENV_H
+
+#include "StringFormat.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// A database without rows: queries return nothing, statements are dropped
+// and async callbacks never run
+
+class Field
+{
+public:
+    template<typename T>
+    T Get() const { return T{}; }
+
+    bool IsNull() const { return true; }
+};
+
+class ResultSet
+{
+public:
+    Field* Fetch() { return fields; }
+    bool NextRow() { return false; }
+    uint64 GetRowCount() const { return 0; }
+    uint32 GetFieldCount() const { return 0; }
+
+private:
+    Field fields[32];
+};
+
+typedef std::shared_ptr<ResultSet> QueryResult;
+
+class Transaction
+{
+public:
+    template<typename... Args>
+    void Append(std::string_view sql, Args&&... args) { (void)Acore::StringFormat(sql, std::forward<Args>(args)...); }
+
+    std::size_t GetSize() const { return 0; }
+};
+
+typedef std::shared_ptr<Transaction> WorldDatabaseTransaction;
+typedef std::shared_ptr<Transaction> CharacterDatabaseTransaction;
+
+class QueryCallback
+{
+public:
+    QueryCallback&& WithCallback(std::function<void(QueryResult)> /*callback*/) && { return std::move(*this); }
+};
+
+class TransactionCallback
+{
+public:
+    void AfterComplete(std::function<void(bool)> /*callback*/) & { }
+};
+
+template<typename T>
+class AsyncCallbackProcessor
+{
+public:
+    T& AddCallback(T&& callback) { callbacks.push_back(std::move(callback)); return callbacks.back(); }
+    void ProcessReadyCallbacks() { callbacks.clear(); }
+
+private:
+    std::vector<T> callbacks;
+};
+
+class QueryCallbackProcessor
+{
+public:
+    void AddCallback(QueryCallback&& /*callback*/) { }
+    void ProcessReadyCallbacks() { }
+};
+
+class DatabaseWorkerPool
+{
+public:
+    template<typename... Args>
+    QueryResult Query(std::string_view sql, Args&&... args) { (void)Acore::StringFormat(sql, std::forward<Args>(args)...); return nullptr; }
+
+    template<typename... Args>
+    void Execute(std::string_view sql, Args&&... args) { (void)Acore::StringFormat(sql, std::forward<Args>(args)...); }
+
+    template<typename... Args>
+    void DirectExecute(std::string_view sql, Args&&... args) { (void)Acore::StringFormat(sql, std::forward<Args>(args)...); }
+
+    QueryCallback AsyncQuery(std::string_view /*sql*/) { return {}; }
+
+    std::shared_ptr<Transaction> BeginTransaction() { return std::make_shared<Transaction>(); }
+    void CommitTransaction(std::shared_ptr<Transaction> /*trans*/) { }
+    void DirectCommitTransaction(std::shared_ptr<Transaction>& /*trans*/) { }
+    TransactionCallback AsyncCommitTransaction(std::shared_ptr<Transaction> /*trans*/) { return {}; }
+
+    void EscapeString(std::string& /*str*/) { }
+};
+
+inline DatabaseWorkerPool WorldDatabase;
+inline DatabaseWorkerPool CharacterDatabase;
+
+#endif // GATHERING_TESTS_DATABASE_ENV_H
@@ -0,0 +1,15 @@
+#ifndef GATHERING_TESTS_GAME_TIME_H
+#define GATHERING_TESTS_GAME_TIME_H
+
+#include "Define.h"
+#include <chrono>
+#include <ctime>
+
+using Seconds = std::chrono::seconds;
+
+namespace GameTime
+{
+    inline Seconds GetGameTime() { return Seconds(std::time(nullptr)); }
+}
+
+#endif // GATHERING_TESTS_GAME_TIME_H
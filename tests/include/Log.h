@@ -0,0 +1,15 @@
+#ifndef GATHERING_TESTS_LOG_H
+#define GATHERING_TESTS_LOG_H
+
+#include "StringFormat.h"
+#include <cstdio>
+
+// Info and debug messages are checked but never formatted, like a server
+// with those levels off. Warnings and errors go to stderr.
+#define LOG_TRACE(filter, ...) do { if (false) (void)Acore::StringFormat(__VA_ARGS__); } while (0)
+#define LOG_DEBUG(filter, ...) LOG_TRACE(filter, __VA_ARGS__)
+#define LOG_INFO(filter, ...) LOG_TRACE(filter, __VA_ARGS__)
+#define LOG_WARN(filter, ...) do { std::fprintf(stderr, "%s\n", Acore::StringFormat(__VA_ARGS__).c_str()); } while (0)
+#define LOG_ERROR(filter, ...) LOG_WARN(filter, __VA_ARGS__)
+
+#endif // GATHERING_TESTS_LOG_H
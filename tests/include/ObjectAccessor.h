@@ -0,0 +1,11 @@
+#ifndef GATHERING_TESTS_OBJECT_ACCESSOR_H
+#define GATHERING_TESTS_OBJECT_ACCESSOR_H
+
+#include "Player.h"
+
+namespace ObjectAccessor
+{
+    inline Player* FindConnectedPlayer(ObjectGuid /*guid*/) { return nullptr; }
+}
+
+#endif // GATHERING_TESTS_OBJECT_ACCESSOR_H
@@ -0,0 +1,46 @@
+#ifndef GATHERING_TESTS_OBJECT_GUID_H
+#define GATHERING_TESTS_OBJECT_GUID_H
+
+#include "Define.h"
+
+enum class HighGuid : uint32
+{
+    Player      = 0x0000,
+    GameObject  = 0xF110,
+    Unit        = 0xF130
+};
+
+// The server's 64 bit guid layout: high type, entry, counter
+class ObjectGuid
+{
+public:
+    typedef uint32 LowType;
+
+    static ObjectGuid const Empty;
+
+    ObjectGuid() = default;
+    explicit ObjectGuid(uint64 guid) : guid(guid) { }
+
+    template<HighGuid type>
+    static ObjectGuid Create(LowType counter) { return ObjectGuid(uint64(type) << 48 | counter); }
+
+    template<HighGuid type>
+    static ObjectGuid Create(uint32 entry, LowType counter) { return ObjectGuid(uint64(type) << 48 | uint64(entry & 0xFFFFFF) << 24 | (counter & 0xFFFFFF)); }
+
+    uint64 GetRawValue() const { return guid; }
+    HighGuid GetHigh() const { return HighGuid(guid >> 48); }
+    LowType GetCounter() const { return GetHigh() == HighGuid::Player ? LowType(guid) : LowType(guid & 0xFFFFFF); }
+    bool IsEmpty() const { return guid == 0; }
+    bool IsPlayer() const { return !IsEmpty() && GetHigh() == HighGuid::Player; }
+
+    bool operator==(ObjectGuid const& other) const { return guid == other.guid; }
+    bool operator!=(ObjectGuid const& other) const { return guid != other.guid; }
+    bool operator<(ObjectGuid const& other) const { return guid < other.guid; }
+
+private:
+    uint64 guid{0};
+};
+
+inline ObjectGuid const ObjectGuid::Empty{};
+
+#endif // GATHERING_TESTS_OBJECT_GUID_H
@@ -0,0 +1,52 @@
+#ifndef GATHERING_TESTS_PLAYER_H
+#define GATHERING_TESTS_PLAYER_H
+
+#include "DataMap.h"
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <string>
+
+// Only declared for signatures; the tests never have a Player, every
+// lookup of one finds none
+
+enum SkillType
+{
+    SKILL_HERBALISM = 182,
+    SKILL_MINING    = 186,
+    SKILL_FISHING   = 356,
+    SKILL_SKINNING  = 393
+};
+
+class Player;
+
+class WorldSession
+{
+public:
+    Player* GetPlayer() const { return nullptr; }
+    uint32 GetAccountId() const { return 0; }
+};
+
+class Item
+{
+public:
+    uint32 GetEntry() const { return 0; }
+};
+
+class Unit
+{
+};
+
+class Player : public Unit
+{
+public:
+    ObjectGuid GetGUID() const { return ObjectGuid(); }
+    WorldSession* GetSession() const { return nullptr; }
+    std::string const& GetName() const { return name; }
+
+    DataMap CustomData;
+
+private:
+    std::string name;
+};
+
+#endif // GATHERING_TESTS_PLAYER_H
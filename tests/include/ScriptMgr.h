@@ -0,0 +1,22 @@
+#ifndef GATHERING_TESTS_SCRIPT_MGR_H
+#define GATHERING_TESTS_SCRIPT_MGR_H
+
+#include "Chat.h"
+#include "Player.h"
+
+// Bases of the module's script class, which the tests never construct
+class PlayerScript
+{
+public:
+    explicit PlayerScript(char const* /*name*/) { }
+    virtual ~PlayerScript() = default;
+};
+
+class WorldScript
+{
+public:
+    explicit WorldScript(char const* /*name*/) { }
+    virtual ~WorldScript() = default;
+};
+
+#endif // GATHERING_TESTS_SCRIPT_MGR_H
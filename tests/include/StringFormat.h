@@ -0,0 +1,38 @@
+#ifndef GATHERING_TESTS_STRING_FORMAT_H
+#define GATHERING_TESTS_STRING_FORMAT_H
+
+#include "Define.h"
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Stands in for the server's fmt based Acore::StringFormat: each {...} is
+// replaced by the next argument, format specs are ignored
+namespace Acore
+{
+    template<typename... Args>
+    std::string StringFormat(std::string_view format, Args&&... args)
+    {
+        std::ostringstream out;
+        [[maybe_unused]] auto next = [&](auto const& arg)
+        {
+            std::size_t open = format.find('{');
+            std::size_t close = format.find('}', open);
+            if (open == std::string_view::npos || close == std::string_view::npos)
+                return;
+
+            out << format.substr(0, open);
+            if constexpr (std::is_integral_v<std::decay_t<decltype(arg)>>)
+                out << +arg;
+            else
+                out << arg;
+            format.remove_prefix(close + 1);
+        };
+        (next(args), ...);
+        out << format;
+        return out.str();
+    }
+}
+
+#endif // GATHERING_TESTS_STRING_FORMAT_H
@@ -0,0 +1,35 @@
+#ifndef GATHERING_TESTS_TIMER_H
+#define GATHERING_TESTS_TIMER_H
+
+#include "Define.h"
+#include <chrono>
+#include <ctime>
+
+inline uint32 getMSTime()
+{
+    using namespace std::chrono;
+    static steady_clock::time_point const start = steady_clock::now();
+    return uint32(duration_cast<milliseconds>(steady_clock::now() - start).count()) + 1;
+}
+
+inline uint32 getMSTimeDiff(uint32 oldMSTime, uint32 newMSTime)
+{
+    return newMSTime - oldMSTime;
+}
+
+namespace Acore::Time
+{
+    // Next time the clock shows hour; the module only asks for any day (-1)
+    inline time_t GetNextTimeWithDayAndHour(int8 /*dayOfWeek*/, int8 hour)
+    {
+        time_t now = std::time(nullptr);
+        std::tm local = *std::localtime(&now);
+        local.tm_hour = hour;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        time_t next = std::mktime(&local);
+        return next > now ? next : next + 24 * 3600;
+    }
+}
+
+#endif // GATHERING_TESTS_TIMER_H